@@ -63,25 +63,44 @@ bool ADPCMStream::rewind() {
 	return true;
 }
 
+uint32 ADPCMStream::readChunk(byte *data, uint32 maxSize) {
+	const int32 pos = _stream->pos();
+	if (_stream->eos() || pos >= _endpos)
+		return 0;
+
+	return _stream->read(data, MIN<uint32>(maxSize, _endpos - pos));
+}
+
 
 #pragma mark -
 
 
 int Oki_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeOKI((data >> 4) & 0x0f);
-			_decodedSamples[1] = decodeOKI((data >> 0) & 0x0f);
-			_decodedSampleCount = 2;
-		}
+	int samples = 0;
+	byte data[kReadChunkSize];
+
+	// Return the sample left over from the previous call first
+	if (_decodedSampleCount != 0 && numSamples > 0) {
+		buffer[samples++] = _decodedSamples[1];
+		_decodedSampleCount = 0;
+	}
+
+	while (samples < numSamples) {
+		const uint32 size = readChunk(data, MIN<uint32>(sizeof(data), (numSamples - samples + 1) / 2));
+		if (size == 0)
+			break;
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+		for (uint32 i = 0; i < size; i++) {
+			buffer[samples++] = decodeOKI((data[i] >> 4) & 0x0f);
+			const int16 sample = decodeOKI((data[i] >> 0) & 0x0f);
+
+			if (samples < numSamples) {
+				buffer[samples++] = sample;
+			} else {
+				_decodedSamples[1] = sample;
+				_decodedSampleCount = 1;
+			}
+		}
 	}
 
 	return samples;
@@ -120,20 +139,32 @@ int16 Oki_ADPCMStream::decodeOKI(byte code) {
 
 
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
-		}
+	int samples = 0;
+	byte data[kReadChunkSize];
+	const int secondChannel = (_channels == 2) ? 1 : 0;
+
+	// Return the sample left over from the previous call first
+	if (_decodedSampleCount != 0 && numSamples > 0) {
+		buffer[samples++] = _decodedSamples[1];
+		_decodedSampleCount = 0;
+	}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+	while (samples < numSamples) {
+		const uint32 size = readChunk(data, MIN<uint32>(sizeof(data), (numSamples - samples + 1) / 2));
+		if (size == 0)
+			break;
+
+		for (uint32 i = 0; i < size; i++) {
+			buffer[samples++] = decodeIMA((data[i] >> 4) & 0x0f, 0);
+			const int16 sample = decodeIMA((data[i] >> 0) & 0x0f, secondChannel);
+
+			if (samples < numSamples) {
+				buffer[samples++] = sample;
+			} else {
+				_decodedSamples[1] = sample;
+				_decodedSampleCount = 1;
+			}
+		}
 	}
 
 	return samples;
@@ -209,43 +240,60 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 #pragma mark -
 
 
-int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	// Need to write at least one sample per channel
-	assert((numSamples % _channels) == 0);
+bool MSIma_ADPCMStream::decodeBlock() {
+	const uint32 size = readChunk(_blockData, _blockAlign);
+	const uint32 headerSize = _channels * 4;
 
-	int samples = 0;
+	_samplePos = 0;
+	_sampleCount = 0;
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
+	if (size < headerSize)
+		return false;
 
-			_blockPos[0] = _channels * 4;
-		}
+	for (int i = 0; i < _channels; i++) {
+		_status.ima_ch[i].last = (int16)READ_LE_UINT16(_blockData + i * 4);
+		_status.ima_ch[i].stepIndex = (int16)READ_LE_UINT16(_blockData + i * 4 + 2);
+	}
+
+	// The block encodes four bytes per channel at a time, which hold eight
+	// samples of that channel. Interleave them while decoding.
+	const byte *data = _blockData + headerSize;
+	const uint32 groups = (size - headerSize) / (_channels * 4);
+
+	for (uint32 group = 0; group < groups; group++) {
+		int16 *out = _decodedBlock + group * 8 * _channels;
 
-		// Decode a set of samples
 		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
 			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
+				out[(j * 2) * _channels + i] = decodeIMA(data[j] & 0x0f, i);
+				out[(j * 2 + 1) * _channels + i] = decodeIMA((data[j] >> 4) & 0x0f, i);
 			}
+
+			data += 4;
 		}
+	}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
+	_sampleCount = groups * 8 * _channels;
+	return true;
+}
+
+int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	// Need to write at least one sample per channel
+	assert((numSamples % _channels) == 0);
+
+	int samples = 0;
 
-			samples += _channels;
+	while (samples < numSamples) {
+		if (_samplePos == _sampleCount) {
+			if (!decodeBlock())
+				break;
+			continue;
 		}
+
+		const uint32 count = MIN<uint32>(numSamples - samples, _sampleCount - _samplePos);
+		memcpy(buffer + samples, _decodedBlock + _samplePos, count * sizeof(int16));
+		samples += count;
+		_samplePos += count;
 	}
 
 	return samples;
@@ -286,45 +334,68 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 	return (int16)predictor;
 }
 
-int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+bool MS_ADPCMStream::decodeBlock() {
+	const uint32 size = readChunk(_blockData, _blockAlign);
+	const uint32 headerSize = _channels * 7;
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
+	_samplePos = 0;
+	_sampleCount = 0;
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
+	if (size < headerSize)
+		return false;
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
+	// read block header
+	const byte *data = _blockData;
+	int16 *out = _decodedBlock;
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++) {
+		_status.ch[i].predictor = CLIP(*data++, (byte)0, (byte)6);
+		_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
+		_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
+	}
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].delta = (int16)READ_LE_UINT16(data);
 
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].sample1 = (int16)READ_LE_UINT16(data);
+
+	for (i = 0; i < _channels; i++, data += 2)
+		*out++ = _status.ch[i].sample2 = (int16)READ_LE_UINT16(data);
+
+	for (i = 0; i < _channels; i++)
+		*out++ = _status.ch[i].sample1;
+
+	// Each byte holds one sample of each channel for stereo blocks, and two
+	// consecutive samples for mono ones
+	ADPCMChannelStatus *first = &_status.ch[0];
+	ADPCMChannelStatus *second = &_status.ch[_channels - 1];
+	const byte *end = _blockData + size;
+
+	for (; data < end; data++) {
+		*out++ = decodeMS(first, (*data >> 4) & 0x0f);
+		*out++ = decodeMS(second, *data & 0x0f);
+	}
+
+	_sampleCount = out - _decodedBlock;
+	return true;
+}
+
+int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_samplePos == _sampleCount) {
+			if (!decodeBlock())
+				break;
+			continue;
 		}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+		const uint32 count = MIN<uint32>(numSamples - samples, _sampleCount - _samplePos);
+		memcpy(buffer + samples, _decodedBlock + _samplePos, count * sizeof(int16));
+		samples += count;
+		_samplePos += count;
 	}
 
 	return samples;
@@ -59,6 +59,17 @@ protected:
 
 	virtual void reset();
 
+	enum {
+		kReadChunkSize = 512
+	};
+
+	/**
+	 * Read up to maxSize bytes of the ADPCM data, without reading past
+	 * the end of the data.
+	 * @return	the number of bytes read
+	 */
+	uint32 readChunk(byte *data, uint32 maxSize);
+
 public:
 	ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
@@ -162,21 +173,34 @@ public:
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockData = new byte[blockAlign];
+		_decodedBlock = new int16[blockAlign * 2];
+		_samplePos = _sampleCount = 0;
+	}
+
+	~MSIma_ADPCMStream() {
+		delete[] _blockData;
+		delete[] _decodedBlock;
 	}
 
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && (_samplePos == _sampleCount); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_samplePos = _sampleCount = 0;
 	}
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	// Blocks are read and decoded as a whole, the decoded samples are
+	// then handed out from _decodedBlock
+	byte *_blockData;
+	int16 *_decodedBlock;
+	uint32 _samplePos;
+	uint32 _sampleCount;
+
+	bool decodeBlock();
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -198,6 +222,7 @@ protected:
 	void reset() {
 		ADPCMStream::reset();
 		memset(&_status, 0, sizeof(_status));
+		_samplePos = _sampleCount = 0;
 	}
 
 public:
@@ -206,10 +231,17 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
+		_blockData = new byte[blockAlign];
+		_decodedBlock = new int16[blockAlign * 2];
+		_samplePos = _sampleCount = 0;
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	~MS_ADPCMStream() {
+		delete[] _blockData;
+		delete[] _decodedBlock;
+	}
+
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && (_samplePos == _sampleCount); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
@@ -217,8 +249,14 @@ protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
 private:
-	uint8 _decodedSampleCount;
-	int16 _decodedSamples[4];
+	// Blocks are read and decoded as a whole, the decoded samples are
+	// then handed out from _decodedBlock
+	byte *_blockData;
+	int16 *_decodedBlock;
+	uint32 _samplePos;
+	uint32 _sampleCount;
+
+	bool decodeBlock();
 };
 
 // Duck DK3 IMA ADPCM Decoder
@@ -31,6 +31,8 @@
 #endif
 
 
+#include "common/threadpool.h"
+
 #include "gui/message.h"
 
 void BaseBackend::displayMessageOnOSD(const char *msg) {
@@ -52,6 +54,10 @@ void BaseBackend::initBackend() {
 		_audiocdManager = new DefaultAudioCDManager();
 #endif
 
+	// Init thread pool, falling back to executing tasks synchronously
+	if (!_threadPool)
+		_threadPool = new Common::ThreadPool();
+
 	OSystem::initBackend();
 }
 
@@ -143,6 +143,7 @@ void ModularBackend::fillScreen(uint32 col) {
 
 void ModularBackend::updateScreen() {
 #ifdef ENABLE_EVENTRECORDER
+	g_eventRec.beginBenchmarkSection(GUI::EventRecorder::kBenchmarkRender);
 	g_eventRec.preDrawOverlayGui();
 #endif
 
@@ -150,6 +151,8 @@ void ModularBackend::updateScreen() {
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
+	g_eventRec.endBenchmarkSection(GUI::EventRecorder::kBenchmarkRender);
+	g_eventRec.finishBenchmarkFrame();
 #endif
 }
 
@@ -70,6 +70,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
 	plugins/sdl/sdl-provider.o \
+	threadpool/sdl/sdl-threadpool.o \
 	timer/sdl/sdl-timer.o
 
 # SDL 1.3 removed audio CD support
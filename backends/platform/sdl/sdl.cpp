@@ -45,6 +45,7 @@
 
 #include "backends/events/sdl/sdl-events.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threadpool/sdl/sdl-threadpool.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -113,6 +114,8 @@ OSystem_SDL::~OSystem_SDL() {
 #endif
 
 	_timerManager = 0;
+	delete _threadPool;
+	_threadPool = 0;
 	delete _mutexManager;
 	_mutexManager = 0;
 
@@ -227,6 +230,9 @@ void OSystem_SDL::initBackend() {
 		_timerManager = new SdlTimerManager();
 #endif
 
+	if (_threadPool == 0)
+		_threadPool = new SdlThreadPool();
+
 	if (_audiocdManager == 0) {
 		// Audio CD support was removed with SDL 1.3
 #if SDL_VERSION_ATLEAST(1, 3, 0)
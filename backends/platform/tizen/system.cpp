@@ -25,6 +25,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/threadpool.h"
 #include "engines/engine.h"
 #include "graphics/font.h"
 #include "graphics/fontman.h"
@@ -292,6 +293,11 @@ result TizenSystem::initModules() {
 		return E_OUT_OF_MEMORY;
 	}
 
+	_threadPool = new Common::ThreadPool();
+	if (!_threadPool) {
+		return E_OUT_OF_MEMORY;
+	}
+
 	if (IsFailed(_audioThread->Start())) {
 		AppLog("Failed to start audio thread");
 		return E_OUT_OF_MEMORY;
@@ -0,0 +1,165 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threadpool/sdl/sdl-threadpool.h"
+#include "common/debug.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#if defined(POSIX)
+#include <unistd.h>
+#endif
+
+SdlThreadPool::SdlThreadPool(uint workerCount) : _workerCount(0), _shouldQuit(false) {
+	if (workerCount == 0)
+		workerCount = MAX<uint>(getCPUCount(), 2) - 1;
+	workerCount = MIN<uint>(workerCount, kMaxWorkers);
+
+	_mutex = SDL_CreateMutex();
+	_queueCond = SDL_CreateCond();
+	_doneCond = SDL_CreateCond();
+
+	for (uint i = 0; i < workerCount; i++) {
+		_workers[_workerCount] = SDL_CreateThread(workerThreadEntry, this);
+		if (!_workers[_workerCount]) {
+			warning("SdlThreadPool: Could not create worker thread: %s", SDL_GetError());
+			break;
+		}
+		_workerCount++;
+	}
+
+	debug(1, "SdlThreadPool: Started %d worker threads", _workerCount);
+}
+
+SdlThreadPool::~SdlThreadPool() {
+	SDL_LockMutex(_mutex);
+	_shouldQuit = true;
+	SDL_CondBroadcast(_queueCond);
+	SDL_UnlockMutex(_mutex);
+
+	for (uint i = 0; i < _workerCount; i++)
+		SDL_WaitThread(_workers[i], NULL);
+
+	// Tasks nobody waited for are left alone, their owners are gone
+	// already or will never ask for the result
+	if (!_queue.empty())
+		warning("SdlThreadPool: %d tasks were never executed", _queue.size());
+
+	SDL_DestroyCond(_doneCond);
+	SDL_DestroyCond(_queueCond);
+	SDL_DestroyMutex(_mutex);
+}
+
+uint SdlThreadPool::getCPUCount() {
+#if defined(POSIX) && defined(_SC_NPROCESSORS_ONLN)
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? count : 1;
+#else
+	return 1;
+#endif
+}
+
+void SdlThreadPool::submit(Common::Task *task) {
+	assert(task->getState() != Common::Task::kStateQueued && task->getState() != Common::Task::kStateRunning);
+
+	if (_workerCount == 0) {
+		ThreadPool::submit(task);
+		return;
+	}
+
+	SDL_LockMutex(_mutex);
+	setTaskState(task, Common::Task::kStateQueued);
+	_queue.push_back(task);
+	SDL_CondSignal(_queueCond);
+	SDL_UnlockMutex(_mutex);
+}
+
+void SdlThreadPool::wait(Common::Task *task) {
+	SDL_LockMutex(_mutex);
+
+	// Waiting for a task which was never submitted would block forever
+	assert(task->getState() != Common::Task::kStateIdle);
+
+	// Rather than blocking on a task no worker started yet, execute it
+	// right here. This also keeps tasks which wait for other tasks from
+	// deadlocking when all workers are busy.
+	if (task->getState() == Common::Task::kStateQueued) {
+		_queue.remove(task);
+		setTaskState(task, Common::Task::kStateRunning);
+		SDL_UnlockMutex(_mutex);
+
+		runTask(task);
+
+		SDL_LockMutex(_mutex);
+	}
+
+	while (task->getState() != Common::Task::kStateFinished)
+		SDL_CondWait(_doneCond, _mutex);
+
+	setTaskState(task, Common::Task::kStateIdle);
+	SDL_UnlockMutex(_mutex);
+}
+
+int SDLCALL SdlThreadPool::workerThreadEntry(void *arg) {
+	SdlThreadPool *pool = (SdlThreadPool *)arg;
+	assert(pool);
+	pool->workerThread();
+	return 0;
+}
+
+void SdlThreadPool::workerThread() {
+	SDL_LockMutex(_mutex);
+	while (true) {
+		while (_queue.empty() && !_shouldQuit)
+			SDL_CondWait(_queueCond, _mutex);
+
+		if (_shouldQuit)
+			break;
+
+		Common::Task *task = _queue.front();
+		_queue.pop_front();
+		setTaskState(task, Common::Task::kStateRunning);
+		SDL_UnlockMutex(_mutex);
+
+		runTask(task);
+
+		SDL_LockMutex(_mutex);
+	}
+	SDL_UnlockMutex(_mutex);
+}
+
+void SdlThreadPool::runTask(Common::Task *task) {
+	task->run();
+
+	SDL_LockMutex(_mutex);
+	setTaskState(task, Common::Task::kStateFinished);
+	SDL_CondBroadcast(_doneCond);
+	SDL_UnlockMutex(_mutex);
+}
+
+#endif
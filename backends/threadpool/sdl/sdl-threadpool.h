@@ -0,0 +1,68 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_THREADPOOL_SDL_H
+#define BACKENDS_THREADPOOL_SDL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/list.h"
+#include "common/threadpool.h"
+
+/**
+ * SDL thread pool. Tasks are executed in submission order by a fixed
+ * number of worker threads.
+ */
+class SdlThreadPool : public Common::ThreadPool {
+public:
+	/**
+	 * Create the pool.
+	 * @param workerCount	number of worker threads, 0 picks one less than
+	 *                      the number of CPU cores (but at least one)
+	 */
+	SdlThreadPool(uint workerCount = 0);
+	virtual ~SdlThreadPool();
+
+	virtual uint getWorkerCount() const { return _workerCount; }
+	virtual void submit(Common::Task *task);
+	virtual void wait(Common::Task *task);
+
+private:
+	enum {
+		kMaxWorkers = 8
+	};
+
+	uint _workerCount;
+	SDL_Thread *_workers[kMaxWorkers];
+	SDL_mutex *_mutex;
+	SDL_cond *_queueCond;
+	SDL_cond *_doneCond;
+	Common::List<Common::Task *> _queue;
+	bool _shouldQuit;
+
+	static uint getCPUCount();
+	static int SDLCALL workerThreadEntry(void *arg);
+	void workerThread();
+	void runTask(Common::Task *task);
+};
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -34,79 +35,167 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
+	// Jitter and run time statistics, logged when the timer is removed
+	uint32 calls;       // number of times the callback was invoked
+	uint32 totalJitter; // sum of the invocation delays (in milliseconds)
+	uint32 maxJitter;   // largest invocation delay (in milliseconds)
+	uint32 maxRunTime;  // longest time spent in the callback (in milliseconds)
+	uint32 overruns;    // number of invocations which took longer than the interval
+
 	TimerSlot *next;
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+DefaultTimerManager::DefaultTimerManager() :
+	_pending(0), _wheelTime(0), _inTick(false), _runningSlot(0), _runningSlotRemoved(false) {
+
+	memset(_wheel, 0, sizeof(_wheel));
+}
+
+static void deleteTimerList(TimerSlot *slot) {
+	while (slot) {
+		TimerSlot *next = slot->next;
+		delete slot;
+		slot = next;
 	}
 }
 
+DefaultTimerManager::~DefaultTimerManager() {
+	Common::StackLock lock(_mutex);
 
-DefaultTimerManager::DefaultTimerManager() :
-	_head(0) {
+	for (int level = 0; level < kWheelLevels; level++)
+		for (int i = 0; i < kWheelSize; i++)
+			deleteTimerList(_wheel[level][i]);
 
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	deleteTimerList(_pending);
 }
 
-DefaultTimerManager::~DefaultTimerManager() {
-	Common::StackLock lock(_mutex);
+void DefaultTimerManager::insertTimer(TimerSlot *slot) {
+	int32 delta = (int32)(slot->nextFireTime - _wheelTime);
+	uint32 expires = slot->nextFireTime;
+
+	// While the current tick is being run, its bucket has already been
+	// emptied. Timers which are due (e.g. timers with an interval of less
+	// than a millisecond, or ones installed by a callback) are run with
+	// the current tick instead of one turn of the wheel later.
+	if (delta <= 0 && _inTick) {
+		slot->next = _pending;
+		_pending = slot;
+		return;
+	}
+
+	// Overdue timers are run with the next tick of the wheel
+	if (delta < 0) {
+		delta = 0;
+		expires = _wheelTime;
+	}
+
+	// Timers which are too far in the future are put into the last bucket
+	// of the highest level. They are moved back here when it is reached.
+	if (delta >= (1 << (kWheelLevels * kWheelBits))) {
+		delta = (1 << (kWheelLevels * kWheelBits)) - 1;
+		expires = _wheelTime + delta;
+	}
+
+	int level = 0;
+	while (level < kWheelLevels - 1 && delta >= (1 << ((level + 1) * kWheelBits)))
+		level++;
+
+	TimerSlot *&bucket = _wheel[level][(expires >> (level * kWheelBits)) & kWheelMask];
+	slot->next = bucket;
+	bucket = slot;
+}
+
+void DefaultTimerManager::cascade(int level) {
+	const uint index = (_wheelTime >> (level * kWheelBits)) & kWheelMask;
+
+	// Redistribute the bucket which became current on the lower levels
+	TimerSlot *slot = _wheel[level][index];
+	_wheel[level][index] = 0;
 
-	TimerSlot *slot = _head;
 	while (slot) {
 		TimerSlot *next = slot->next;
-		delete slot;
+		insertTimer(slot);
 		slot = next;
 	}
-	_head = 0;
 }
 
-void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+void DefaultTimerManager::runTimers(uint32 curTime) {
+	// Repeat as long as there is a tick of the wheel which is due.
+	while ((int32)(curTime - _wheelTime) > 0) {
+		const uint index = _wheelTime & kWheelMask;
 
-	uint32 curTime = g_system->getMillis(true);
+		// Refill the first level from the higher levels when wrapping around
+		for (int level = 1; level < kWheelLevels; level++) {
+			if (((_wheelTime >> ((level - 1) * kWheelBits)) & kWheelMask) != 0)
+				break;
+			cascade(level);
+		}
+
+		// The timers of the current tick are moved to a separate list. It is
+		// a member, so that removeTimerProc() called from a callback finds
+		// the timers which were not run yet.
+		_pending = _wheel[0][index];
+		_wheel[0][index] = 0;
+		_inTick = true;
+
+		while (_pending) {
+			TimerSlot *slot = _pending;
+			_pending = slot->next;
+
+			const uint32 scheduledTime = slot->nextFireTime;
+
+			// Update the fire time and reinsert the TimerSlot
+			assert(slot->interval > 0);
+			slot->nextFireTime += (slot->interval / 1000);
+			slot->nextFireTimeMicro += (slot->interval % 1000);
+			if (slot->nextFireTimeMicro > 1000) {
+				slot->nextFireTime += slot->nextFireTimeMicro / 1000;
+				slot->nextFireTimeMicro %= 1000;
+			}
+
+			insertTimer(slot);
 
-	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
-		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+			// Invoke the timer callback
+			assert(slot->callback);
+			_runningSlot = slot;
+			_runningSlotRemoved = false;
+			const uint32 startTime = g_system->getMillis(true);
+			slot->callback(slot->refCon);
+			const uint32 runTime = g_system->getMillis(true) - startTime;
+			_runningSlot = 0;
+
+			// The callback removed its own timer
+			if (_runningSlotRemoved) {
+				delete slot;
+				continue;
+			}
+
+			const uint32 jitter = (int32)(startTime - scheduledTime) > 0 ? startTime - scheduledTime : 0;
+			slot->calls++;
+			slot->totalJitter += jitter;
+			slot->maxJitter = MAX(slot->maxJitter, jitter);
+			slot->maxRunTime = MAX(slot->maxRunTime, runTime);
+			if (runTime * 1000 > slot->interval)
+				slot->overruns++;
 		}
-		insertPrioQueue(_head, slot);
 
-		// Invoke the timer callback
-		assert(slot->callback);
-		slot->callback(slot->refCon);
+		_inTick = false;
+		_wheelTime++;
+	}
+}
+
+void DefaultTimerManager::handler() {
+	Common::StackLock lock(_mutex);
+
+	uint32 curTime = g_system->getMillis(true);
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+	// Nothing to catch up with when there are no timers
+	if (_callbacks.empty()) {
+		_wheelTime = curTime;
+		return;
 	}
+
+	runTimers(curTime);
 }
 
 bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, void *refCon, const Common::String &id) {
@@ -125,6 +214,14 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 			error("Same callback added twice (old name: %s, new name: %s)", i->_key.c_str(), id.c_str());
 		}
 	}
+
+	// The wheel uses the same time source as handler()
+	const uint32 curTime = g_system->getMillis(true);
+
+	// The wheel does not advance while it's empty
+	if (_callbacks.empty())
+		_wheelTime = curTime;
+
 	_callbacks[id] = callback;
 
 	TimerSlot *slot = new TimerSlot;
@@ -132,30 +229,54 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
+	slot->nextFireTime = curTime + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
+	slot->calls = 0;
+	slot->totalJitter = 0;
+	slot->maxJitter = 0;
+	slot->maxRunTime = 0;
+	slot->overruns = 0;
 	slot->next = 0;
 
-	insertPrioQueue(_head, slot);
+	insertTimer(slot);
 
 	return true;
 }
 
-void DefaultTimerManager::removeTimerProc(TimerProc callback) {
-	Common::StackLock lock(_mutex);
+bool DefaultTimerManager::unlinkTimer(TimerSlot **list, TimerProc callback) {
+	bool found = false;
+
+	while (*list) {
+		TimerSlot *slot = *list;
+		if (slot->callback == callback) {
+			debug(3, "Timer '%s': %u calls, jitter avg %u ms max %u ms, max run time %u ms, %u overruns",
+			      slot->id.c_str(), slot->calls, slot->calls ? slot->totalJitter / slot->calls : 0,
+			      slot->maxJitter, slot->maxRunTime, slot->overruns);
 
-	TimerSlot *slot = _head;
+			*list = slot->next;
+			found = true;
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
+			// The slot of a running callback is deleted by runTimers() once
+			// the callback returned.
+			if (slot == _runningSlot)
+				_runningSlotRemoved = true;
+			else
+				delete slot;
 		} else {
-			slot = slot->next;
+			list = &slot->next;
 		}
 	}
 
+	return found;
+}
+
+void DefaultTimerManager::removeTimerProc(TimerProc callback) {
+	Common::StackLock lock(_mutex);
+
+	unlinkTimer(&_pending, callback);
+	for (int level = 0; level < kWheelLevels; level++)
+		for (int i = 0; i < kWheelSize; i++)
+			unlinkTimer(&_wheel[level][i], callback);
 	// We need to remove all names referencing the timer proc here.
 	//
 	// Else we run into troubles, when the client code removes and readds timer
@@ -30,14 +30,41 @@
 
 struct TimerSlot;
 
+/**
+ * Timer manager based on a hierarchical timing wheel.
+ *
+ * Timers are kept in buckets indexed by their next fire time (in
+ * milliseconds). The first level has one bucket per millisecond, each
+ * further level covers the whole range of the level below in one bucket.
+ * Buckets of higher levels are redistributed to the lower levels when
+ * the wheel reaches them. This makes installing, firing and rescheduling
+ * a timer O(1), independent of the number of installed timers.
+ */
 class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
+	enum {
+		kWheelLevels = 4,
+		kWheelBits = 6,
+		kWheelSize = 1 << kWheelBits,
+		kWheelMask = kWheelSize - 1
+	};
+
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	TimerSlot *_wheel[kWheelLevels][kWheelSize];
+	TimerSlot *_pending;
+	uint32 _wheelTime;
+	bool _inTick;
+	TimerSlot *_runningSlot;
+	bool _runningSlotRemoved;
 	TimerSlotMap _callbacks;
 
+	void insertTimer(TimerSlot *slot);
+	void cascade(int level);
+	void runTimers(uint32 curTime);
+	bool unlinkTimer(TimerSlot **list, TimerProc callback);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
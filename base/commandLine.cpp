@@ -124,6 +124,10 @@ static const char HELP_STRING[] =
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
+	"  --benchmark              Play back the record file as fast as possible and\n"
+	"                           report frame timings (use SDL_VIDEODRIVER=dummy to\n"
+	"                           run without a display)\n"
+	"  --benchmark-file=FILE    Write per-frame timings and the summary to FILE as JSON\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -242,6 +246,8 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("benchmark", false);
+	ConfMan.registerDefault("benchmark_file", "");
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -439,6 +445,12 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("benchmark")
+			END_OPTION
+
+			DO_LONG_OPTION("benchmark-file")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
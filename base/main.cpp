@@ -476,7 +476,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 			if (recordMode == "record") {
 				g_eventRec.init(g_eventRec.generateRecordFileName(ConfMan.getActiveDomainName()), GUI::EventRecorder::kRecorderRecord);
-			} else if (recordMode == "playback") {
+			} else if (recordMode == "playback" || ConfMan.getBool("benchmark")) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
@@ -33,6 +33,7 @@
 #include "common/macresman.h"
 #include "common/memstream.h"
 #include "common/quicktime.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 #include "common/zlib.h"
@@ -132,8 +133,62 @@ void QuickTimeParser::init() {
 				_tracks[i]->editList[0].mediaTime = 0;
 				_tracks[i]->editList[0].mediaRate = 1;
 			}
+
+			if (_tracks[i]->codecType == CODEC_TYPE_VIDEO)
+				buildSampleTable(_tracks[i]);
+		}
+	}
+}
+
+void QuickTimeParser::buildSampleTable(Track *track) {
+	uint32 startMillis = g_system->getMillis();
+
+	track->sampleTable.resize(track->frameCount);
+
+	// Timing of each sample
+	uint32 sample = 0;
+	uint32 time = 0;
+	for (int32 i = 0; i < track->timeToSampleCount; i++) {
+		for (int32 j = 0; j < track->timeToSample[i].count && sample < track->frameCount; j++, sample++) {
+			track->sampleTable[sample].startTime = time;
+			track->sampleTable[sample].duration = track->timeToSample[i].duration;
+			time += track->timeToSample[i].duration;
+		}
+	}
+
+	// Location of each sample. Samples for which no chunk exists are left
+	// with a description id of 0.
+	sample = 0;
+	uint32 sampleToChunkIndex = 0;
+	for (uint32 i = 0; i < track->chunkCount && sample < track->frameCount; i++) {
+		if (sampleToChunkIndex < track->sampleToChunkCount && i >= track->sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		const SampleToChunkEntry &entry = track->sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = track->chunkOffsets[i];
+
+		for (uint32 j = 0; j < entry.count && sample < track->frameCount; j++, sample++) {
+			uint32 size = track->sampleSize;
+			if (size == 0)
+				size = (sample < track->sampleCount) ? track->sampleSizes[sample] : 0;
+
+			track->sampleTable[sample].offset = offset;
+			track->sampleTable[sample].size = size;
+			track->sampleTable[sample].descId = entry.id;
+			offset += size;
 		}
 	}
+
+	for (; sample < track->frameCount; sample++) {
+		track->sampleTable[sample].offset = 0;
+		track->sampleTable[sample].size = 0;
+		track->sampleTable[sample].descId = 0;
+	}
+
+	debug(2, "Built sample table with %d entries in %d ms", track->frameCount, g_system->getMillis() - startMillis);
 }
 
 void QuickTimeParser::initParseTable() {
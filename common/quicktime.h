@@ -103,6 +103,19 @@ protected:
 		Rational mediaRate;
 	};
 
+	/**
+	 * Everything needed to locate and time one sample of a track,
+	 * flattened from the chunk, sample-to-chunk, sample size and
+	 * time-to-sample tables.
+	 */
+	struct SampleEntry {
+		uint32 offset;    ///< file offset of the sample data
+		uint32 size;      ///< size of the sample data
+		uint32 startTime; ///< media time at which the sample starts
+		uint32 duration;  ///< media duration of the sample
+		uint32 descId;    ///< 1-based sample description index, 0 if the sample has no data
+	};
+
 	struct Track;
 
 	class SampleDesc {
@@ -144,6 +157,9 @@ protected:
 		uint32 *keyframes;
 		int32 timeScale;
 
+		// Only built for video tracks, one entry per frame
+		Array<SampleEntry> sampleTable;
+
 		uint16 width;
 		uint16 height;
 		CodecType codecType;
@@ -190,6 +206,7 @@ private:
 	bool _foundMOOV;
 
 	void initParseTable();
+	void buildSampleTable(Track *track);
 
 	int readDefault(Atom atom);
 	int readLeaf(Atom atom);
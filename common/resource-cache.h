@@ -0,0 +1,254 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_RESOURCE_CACHE_H
+#define COMMON_RESOURCE_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * Least recently used cache for loaded resources, limited by the total
+ * size of the resources rather than by their number.
+ *
+ * The cache does not own the resource data. Whenever an entry leaves the
+ * cache, because it got evicted or because it was removed explicitly, the
+ * eviction callback is invoked so that the owner can free the data.
+ *
+ * Pinned entries are never evicted. They still count towards the size of
+ * the cache, so the cache may grow beyond its budget if too many entries
+ * are pinned at the same time.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class ResourceCache : NonCopyable {
+public:
+	typedef void (*EvictProc)(const Key &key, Val &value, void *refCon);
+
+	/**
+	 * @param budget	total size (in bytes) of the unpinned entries kept
+	 * @param proc		callback invoked for each entry leaving the cache
+	 * @param refCon	an arbitrary pointer passed to the callback
+	 */
+	ResourceCache(uint32 budget, EvictProc proc = 0, void *refCon = 0)
+		: _budget(budget), _size(0), _evictProc(proc), _refCon(refCon),
+		  _lruHead(0), _lruTail(0), _hits(0), _misses(0), _evictions(0) {
+	}
+
+	~ResourceCache() {
+		clear();
+	}
+
+	/** Return the size budget in bytes. */
+	uint32 getBudget() const { return _budget; }
+
+	/** Change the size budget, evicting entries if necessary. */
+	void setBudget(uint32 budget) {
+		_budget = budget;
+		shrink(0);
+	}
+
+	/** Return the total size of the cached entries in bytes. */
+	uint32 getSize() const { return _size; }
+
+	/** Return the number of cached entries. */
+	uint getCount() const { return _nodes.size(); }
+
+	bool contains(const Key &key) const { return _nodes.contains(key); }
+
+	/**
+	 * Look up an entry and mark it as most recently used.
+	 * @return	the cached value, or 0 if the key is not cached
+	 */
+	Val *get(const Key &key) {
+		typename NodeMap::iterator i = _nodes.find(key);
+		if (i == _nodes.end()) {
+			_misses++;
+			return 0;
+		}
+
+		_hits++;
+		Node *node = i->_value;
+		if (!node->pinCount) {
+			unlinkNode(node);
+			linkFront(node);
+		}
+		return &node->value;
+	}
+
+	/**
+	 * Add an entry, replacing any entry with the same key. Other
+	 * entries are evicted first if the new one does not fit into the
+	 * budget; the new entry itself is always added.
+	 */
+	void insert(const Key &key, const Val &value, uint32 size) {
+		remove(key);
+		shrink(size);
+
+		Node *node = new Node(key, value, size);
+		_nodes[key] = node;
+		_size += size;
+		linkFront(node);
+	}
+
+	/**
+	 * Remove an entry from the cache. The eviction callback is invoked
+	 * for it, even when it is pinned.
+	 * @return	true if the key was cached
+	 */
+	bool remove(const Key &key) {
+		typename NodeMap::iterator i = _nodes.find(key);
+		if (i == _nodes.end())
+			return false;
+
+		Node *node = i->_value;
+		_nodes.erase(i);
+		release(node);
+		return true;
+	}
+
+	/**
+	 * Evict the least recently used unpinned entry. This is useful if
+	 * the owner runs short of something else than memory.
+	 * @return	false if there is no unpinned entry
+	 */
+	bool evictOldest() {
+		if (!_lruTail)
+			return false;
+
+		Node *node = _lruTail;
+		_nodes.erase(node->key);
+		_evictions++;
+		release(node);
+		return true;
+	}
+
+	/** Remove all entries, including the pinned ones. */
+	void clear() {
+		for (typename NodeMap::iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+			release(i->_value);
+		_nodes.clear();
+	}
+
+	/**
+	 * Protect an entry from eviction. Calls nest, the entry becomes
+	 * evictable again once unpin() was called as often as pin().
+	 * Unpinning does not evict anything by itself, the cache only shrinks
+	 * back to its budget when the next entry is inserted.
+	 */
+	void pin(const Key &key) {
+		typename NodeMap::iterator i = _nodes.find(key);
+		assert(i != _nodes.end());
+		Node *node = i->_value;
+		if (!node->pinCount++)
+			unlinkNode(node);
+	}
+
+	void unpin(const Key &key) {
+		typename NodeMap::iterator i = _nodes.find(key);
+		assert(i != _nodes.end());
+		Node *node = i->_value;
+		assert(node->pinCount > 0);
+		if (!--node->pinCount)
+			linkFront(node);
+	}
+
+	bool isPinned(const Key &key) const {
+		typename NodeMap::const_iterator i = _nodes.find(key);
+		return i != _nodes.end() && i->_value->pinCount > 0;
+	}
+
+	/** @name Statistics */
+	//@{
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+	void resetStats() { _hits = _misses = _evictions = 0; }
+	//@}
+
+private:
+	struct Node {
+		Key key;
+		Val value;
+		uint32 size;
+		uint pinCount;
+		Node *prev, *next;
+
+		Node(const Key &k, const Val &v, uint32 s) : key(k), value(v), size(s), pinCount(0), prev(0), next(0) {}
+	};
+
+	typedef HashMap<Key, Node *, HashFunc, EqualFunc> NodeMap;
+
+	uint32 _budget;
+	uint32 _size;
+	EvictProc _evictProc;
+	void *_refCon;
+
+	NodeMap _nodes;
+	// Unpinned entries only, most recently used first
+	Node *_lruHead, *_lruTail;
+
+	uint32 _hits, _misses, _evictions;
+
+	void linkFront(Node *node) {
+		node->prev = 0;
+		node->next = _lruHead;
+		if (_lruHead)
+			_lruHead->prev = node;
+		_lruHead = node;
+		if (!_lruTail)
+			_lruTail = node;
+	}
+
+	void unlinkNode(Node *node) {
+		if (_lruHead == node)
+			_lruHead = node->next;
+		if (_lruTail == node)
+			_lruTail = node->prev;
+		if (node->prev)
+			node->prev->next = node->next;
+		if (node->next)
+			node->next->prev = node->prev;
+		node->prev = node->next = 0;
+	}
+
+	void release(Node *node) {
+		if (!node->pinCount)
+			unlinkNode(node);
+		_size -= node->size;
+		if (_evictProc)
+			_evictProc(node->key, node->value, _refCon);
+		delete node;
+	}
+
+	/** Evict the least recently used entries until extra bytes fit in. */
+	void shrink(uint32 extra) {
+		while (_size + extra > _budget && evictOldest())
+			;
+	}
+};
+
+} // End of namespace Common
+
+#endif
@@ -30,6 +30,7 @@
 #include "common/taskbar.h"
 #include "common/updates.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "gui/EventRecorder.h"
 #endif
@@ -44,6 +45,7 @@ OSystem::OSystem() {
 	_audiocdManager = 0;
 	_eventManager = 0;
 	_timerManager = 0;
+	_threadPool = 0;
 	_savefileManager = 0;
 #if defined(USE_TASKBAR)
 	_taskbarManager = 0;
@@ -64,6 +66,9 @@ OSystem::~OSystem() {
 	delete _timerManager;
 	_timerManager = 0;
 
+	delete _threadPool;
+	_threadPool = 0;
+
 #if defined(USE_TASKBAR)
 	delete _taskbarManager;
 	_taskbarManager = 0;
@@ -89,6 +94,8 @@ void OSystem::initBackend() {
 		error("Backend failed to instantiate event manager");
 	if (!getTimerManager())
 		error("Backend failed to instantiate timer manager");
+	if (!_threadPool)
+		error("Backend failed to instantiate thread pool");
 
 	// TODO: We currently don't check _savefileManager, because at least
 	// on the Nintendo DS, it is possible that none is set. That should
@@ -49,6 +49,7 @@ class TaskbarManager;
 class UpdateManager;
 #endif
 class TimerManager;
+class ThreadPool;
 class SeekableReadStream;
 class WriteStream;
 #ifdef ENABLE_KEYMAPPER
@@ -153,6 +154,15 @@ protected:
 	 */
 	Common::TimerManager *_timerManager;
 
+	/**
+	 * No default value is provided for _threadPool by OSystem.
+	 * However, BaseBackend::initBackend() does set a default value
+	 * if none has been set before.
+	 *
+	 * @note _threadPool is deleted by the OSystem destructor.
+	 */
+	Common::ThreadPool *_threadPool;
+
 	/**
 	 * No default value is provided for _savefileManager by OSystem.
 	 *
@@ -915,6 +925,16 @@ public:
 	 */
 	virtual Common::TimerManager *getTimerManager();
 
+	/**
+	 * Return the thread pool singleton, which can be used to run
+	 * Common::Task objects on worker threads. On backends without
+	 * thread support, tasks are executed synchronously instead.
+	 * For more information, refer to the ThreadPool documentation.
+	 */
+	inline Common::ThreadPool *getThreadPool() {
+		return _threadPool;
+	}
+
 	/**
 	 * Return the event manager singleton. For more information, refer
 	 * to the EventManager documentation.
@@ -977,6 +997,9 @@ public:
 	 *
 	 * Hence backends which do not use threads to implement the timers simply
 	 * can use dummy implementations for these methods.
+	 *
+	 * Engines which want to offload work to other threads should use
+	 * getThreadPool() rather than creating threads themselves.
 	 */
 	//@{
 
@@ -0,0 +1,99 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/util.h"
+
+namespace Common {
+
+void ThreadPool::submit(Task *task) {
+	assert(task->getState() != Task::kStateQueued && task->getState() != Task::kStateRunning);
+
+	setTaskState(task, Task::kStateRunning);
+	task->run();
+	setTaskState(task, Task::kStateFinished);
+}
+
+void ThreadPool::wait(Task *task) {
+	assert(task->getState() == Task::kStateFinished);
+	setTaskState(task, Task::kStateIdle);
+}
+
+namespace {
+
+class ParallelForTask : public Task {
+public:
+	ParallelForTask() : _begin(0), _end(0), _proc(0), _refCon(0) {}
+
+	void set(int begin, int end, ThreadPool::ParallelForProc proc, void *refCon) {
+		_begin = begin;
+		_end = end;
+		_proc = proc;
+		_refCon = refCon;
+	}
+
+	virtual void run() {
+		_proc(_begin, _end, _refCon);
+	}
+
+private:
+	int _begin, _end;
+	ThreadPool::ParallelForProc _proc;
+	void *_refCon;
+};
+
+} // End of anonymous namespace
+
+void ThreadPool::parallelFor(int begin, int end, ParallelForProc proc, void *refCon, int minChunkSize) {
+	if (begin >= end)
+		return;
+
+	const int count = end - begin;
+	minChunkSize = MAX(minChunkSize, 1);
+	int chunks = MIN<int>(getWorkerCount() + 1, (count + minChunkSize - 1) / minChunkSize);
+	if (chunks <= 1) {
+		proc(begin, end, refCon);
+		return;
+	}
+
+	const int chunkSize = (count + chunks - 1) / chunks;
+	chunks = (count + chunkSize - 1) / chunkSize;
+
+	// The first chunk is handled by the calling thread, which would only
+	// be waiting otherwise
+	ParallelForTask *tasks = new ParallelForTask[chunks - 1];
+
+	for (int i = 1; i < chunks; i++) {
+		const int chunkBegin = begin + i * chunkSize;
+		tasks[i - 1].set(chunkBegin, MIN(chunkBegin + chunkSize, end), proc, refCon);
+		submit(&tasks[i - 1]);
+	}
+
+	proc(begin, begin + chunkSize, refCon);
+
+	for (int i = 0; i < chunks - 1; i++)
+		wait(&tasks[i]);
+
+	delete[] tasks;
+}
+
+} // End of namespace Common
@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * A unit of work which can be handed to a ThreadPool.
+ *
+ * The task doubles as the future of its result: subclasses store whatever
+ * run() produces in their own members, which may be accessed once
+ * ThreadPool::wait() returned for the task. The task is owned by the
+ * caller and has to stay alive until then.
+ */
+class Task : NonCopyable {
+	friend class ThreadPool;
+public:
+	enum State {
+		kStateIdle,     ///< not submitted yet, or already waited for
+		kStateQueued,   ///< submitted, but not picked up by a worker yet
+		kStateRunning,  ///< run() is currently being executed
+		kStateFinished  ///< run() returned, the result can be collected
+	};
+
+	Task() : _state(kStateIdle) {}
+	virtual ~Task() {}
+
+	/**
+	 * Perform the actual work. This may be called from a worker thread,
+	 * so it must not call into the OSystem API except for the mutex
+	 * functions, and must not touch engine state other threads use
+	 * without syncing.
+	 */
+	virtual void run() = 0;
+
+	/**
+	 * Check whether the task has been executed. This is only a hint
+	 * for polling, ThreadPool::wait() has to be called before the
+	 * result is accessed.
+	 */
+	bool isFinished() const { return _state == kStateFinished; }
+
+	State getState() const { return _state; }
+
+private:
+	volatile State _state;
+};
+
+/**
+ * Pool of worker threads which execute Tasks.
+ *
+ * This base class is the single-threaded fallback for backends which have
+ * no thread support: submitted tasks are executed right away on the
+ * calling thread. Backends with threads derive from it, see
+ * OSystem::getThreadPool().
+ */
+class ThreadPool : NonCopyable {
+public:
+	typedef void (*ParallelForProc)(int begin, int end, void *refCon);
+
+	virtual ~ThreadPool() {}
+
+	/**
+	 * Return the number of worker threads. 0 means tasks are executed
+	 * synchronously by submit().
+	 */
+	virtual uint getWorkerCount() const { return 0; }
+
+	/**
+	 * Queue a task for execution. The task must not be queued already.
+	 * Each submitted task has to be waited for with wait().
+	 */
+	virtual void submit(Task *task);
+
+	/**
+	 * Block until the given task has been executed. If no worker picked
+	 * it up yet, the calling thread executes it itself. Afterwards the
+	 * task may be submitted again or deleted.
+	 */
+	virtual void wait(Task *task);
+
+	/**
+	 * Call proc for consecutive subranges of [begin, end), spread over
+	 * the worker threads and the calling thread, and return when all of
+	 * them are done. The subranges contain at least minChunkSize
+	 * elements, except for the last one.
+	 */
+	void parallelFor(int begin, int end, ParallelForProc proc, void *refCon, int minChunkSize = 1);
+
+protected:
+	static void setTaskState(Task *task, Task::State state) { task->_state = state; }
+};
+
+} // End of namespace Common
+
+#endif
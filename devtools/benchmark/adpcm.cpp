@@ -0,0 +1,68 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decoders/adpcm.h"
+#include "audio/audiostream.h"
+
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include "benchmark.h"
+
+struct ADPCMConfig {
+	const char *name;
+	Audio::ADPCMType type;
+	int channels;
+	uint32 blockAlign;
+};
+
+static const ADPCMConfig adpcmConfigs[] = {
+	{ "Oki",             Audio::kADPCMOki,   1,    0 },
+	{ "DVI mono",        Audio::kADPCMDVI,   1,    0 },
+	{ "DVI stereo",      Audio::kADPCMDVI,   2,    0 },
+	{ "MS IMA mono",     Audio::kADPCMMSIma, 1,  512 },
+	{ "MS IMA stereo",   Audio::kADPCMMSIma, 2, 1024 },
+	{ "MS ADPCM mono",   Audio::kADPCMMS,    1,  256 },
+	{ "MS ADPCM stereo", Audio::kADPCMMS,    2,  512 }
+};
+
+void runADPCMBenchmark() {
+	const uint32 size = 4 * 1024 * 1024;
+
+	for (uint i = 0; i < ARRAYSIZE(adpcmConfigs); i++) {
+		const ADPCMConfig &config = adpcmConfigs[i];
+		byte *data = createNoise(size, 99);
+
+		// MS IMA block headers hold the step index, which has to be valid
+		if (config.type == Audio::kADPCMMSIma) {
+			for (uint32 block = 0; block < size; block += config.blockAlign) {
+				for (int j = 0; j < config.channels; j++) {
+					data[block + j * 4 + 2] %= 89;
+					data[block + j * 4 + 3] = 0;
+				}
+			}
+		}
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+		measureStream(config.name, Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, config.type, 22050, config.channels, config.blockAlign), 4);
+	}
+}
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for measuring the throughput of decoders, which is
+ * not part of the unit tests, as timings are too unreliable there.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio/audiostream.h"
+
+#include "common/util.h"
+
+#include "benchmark.h"
+
+void measureStream(const char *name, Audio::RewindableAudioStream *stream, int passes) {
+	int16 buffer[2048];
+	uint64 samples = 0;
+
+	const clock_t start = clock();
+	for (int i = 0; i < passes; i++) {
+		int count;
+		while ((count = stream->readBuffer(buffer, ARRAYSIZE(buffer))) > 0)
+			samples += count;
+		stream->rewind();
+	}
+	const double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	delete stream;
+
+	if (seconds > 0)
+		printf("%-20s %8.1f Msamples/s\n", name, samples / seconds / 1000000);
+	else
+		printf("%-20s %8s Msamples/s\n", name, "-");
+}
+
+byte *createNoise(uint32 size, uint32 seed) {
+	byte *data = (byte *)malloc(size);
+	for (uint32 i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (seed >> 16) & 0xFF;
+	}
+	return data;
+}
+
+struct Benchmark {
+	const char *name;
+	void (*run)();
+};
+
+static const Benchmark benchmarks[] = {
+	{ "adpcm", runADPCMBenchmark },
+#ifdef ENABLE_SAGA2
+	{ "shorten", runShortenBenchmark },
+#endif
+};
+
+int main(int argc, char *argv[]) {
+	if (argc > 2) {
+		printf("Usage: %s [name]\n", argv[0]);
+		printf("Runs the named benchmark, or all of them. Available:");
+		for (uint i = 0; i < ARRAYSIZE(benchmarks); i++)
+			printf(" %s", benchmarks[i].name);
+		printf("\n");
+		return -1;
+	}
+
+	bool found = false;
+	for (uint i = 0; i < ARRAYSIZE(benchmarks); i++) {
+		if (argc == 2 && strcmp(argv[1], benchmarks[i].name))
+			continue;
+		printf("%s:\n", benchmarks[i].name);
+		benchmarks[i].run();
+		found = true;
+	}
+
+	if (!found) {
+		printf("Unknown benchmark '%s'\n", argv[1]);
+		return -1;
+	}
+	return 0;
+}
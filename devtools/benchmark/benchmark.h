@@ -0,0 +1,53 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for measuring the throughput of decoders, which is
+ * not part of the unit tests, as timings are too unreliable there.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "common/scummsys.h"
+
+namespace Audio {
+class RewindableAudioStream;
+}
+
+/**
+ * Read the given stream to its end the given number of times, rewinding
+ * it in between, and print the number of samples decoded per second.
+ * The stream is deleted afterwards.
+ */
+void measureStream(const char *name, Audio::RewindableAudioStream *stream, int passes);
+
+/**
+ * Fill a buffer with pseudo-random bytes. The same seed always gives the
+ * same data, so results stay comparable between runs.
+ */
+byte *createNoise(uint32 size, uint32 seed);
+
+void runADPCMBenchmark();
+
+#ifdef ENABLE_SAGA2
+void runShortenBenchmark();
+#endif
+
+#endif
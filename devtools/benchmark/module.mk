@@ -0,0 +1,23 @@
+
+MODULE := devtools/benchmark
+
+MODULE_OBJS := \
+	adpcm.o \
+	benchmark.o \
+	shorten.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := benchmark
+
+# The decoders are taken from the regular libraries. Shorten is only
+# built together with SAGA2.
+TOOL_DEPS :=
+ifdef ENABLE_SAGA2
+TOOL_DEPS += engines/saga/shorten.o
+endif
+TOOL_DEPS += \
+	audio/libaudio.a \
+	common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef ENABLE_SAGA2
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+#include "saga/shorten.h"
+
+#include "benchmark.h"
+
+/**
+ * Minimal Shorten encoder, only writing what the benchmark needs: random
+ * residuals for the DIFF0 to DIFF3 predictors and some ZERO blocks.
+ */
+class ShortenWriter {
+public:
+	ShortenWriter() : _bits(0), _bitCount(0) {}
+
+	void writeBit(int bit) {
+		_bits = (_bits << 1) | (bit & 1);
+		if (++_bitCount == 32) {
+			for (int i = 3; i >= 0; i--)
+				_data.push_back((_bits >> (i * 8)) & 0xFF);
+			_bits = 0;
+			_bitCount = 0;
+		}
+	}
+
+	void writeBits(uint32 value, int count) {
+		for (int i = count - 1; i >= 0; i--)
+			writeBit(value >> i);
+	}
+
+	void writeUnsigned(uint32 value, int bits) {
+		for (uint32 i = 0; i < (value >> bits); i++)
+			writeBit(0);
+		writeBit(1);
+		writeBits(value, bits);
+	}
+
+	void writeSigned(int32 value, int bits) {
+		writeUnsigned(value < 0 ? ((~(uint32)value) << 1) | 1 : (uint32)value << 1, bits + 1);
+	}
+
+	void writeLong(uint32 value) {
+		int bits = 0;
+		while (bits < 32 && (value >> bits))
+			bits++;
+		writeUnsigned(bits, 2);
+		writeUnsigned(value, bits);
+	}
+
+	void writeByte(byte value) {
+		_data.push_back(value);
+	}
+
+	Common::Array<byte> &finish() {
+		while (_bitCount)
+			writeBit(0);
+		return _data;
+	}
+
+private:
+	Common::Array<byte> _data;
+	uint32 _bits;
+	int _bitCount;
+};
+
+enum {
+	kShortenTypeS16LH = 5,
+	kShortenBlockSize = 256,
+	kShortenFnQuit = 4,
+	kShortenFnZero = 8
+};
+
+static byte *createShortenFile(int channels, int blocks, uint32 &size) {
+	ShortenWriter writer;
+	const char *magic = "ajkg";
+	for (int i = 0; i < 4; i++)
+		writer.writeByte(magic[i]);
+	writer.writeByte(2); // version
+
+	writer.writeLong(kShortenTypeS16LH);
+	writer.writeLong(channels);
+	writer.writeLong(kShortenBlockSize);
+	writer.writeLong(0); // maximum LPC order
+	writer.writeLong(4); // blocks in the running mean
+	writer.writeLong(0); // bytes to skip
+
+	uint32 seed = 7;
+	for (int block = 0; block < blocks; block++) {
+		for (int channel = 0; channel < channels; channel++) {
+			seed = seed * 1103515245 + 12345;
+			const uint32 choice = (seed >> 16) % 10;
+			const int command = choice < 5 ? 0 : choice < 7 ? 1 : choice < 8 ? 2 : choice < 9 ? 3 : kShortenFnZero;
+			writer.writeUnsigned(command, 2);
+			if (command == kShortenFnZero)
+				continue;
+
+			const int energy = 6;
+			writer.writeUnsigned(energy, 3);
+			for (int i = 0; i < kShortenBlockSize; i++) {
+				seed = seed * 1103515245 + 12345;
+				writer.writeSigned((int32)((seed >> 16) % (2 << energy)) - (1 << energy), energy);
+			}
+		}
+	}
+	writer.writeUnsigned(kShortenFnQuit, 2);
+
+	Common::Array<byte> &data = writer.finish();
+	size = data.size();
+	byte *file = (byte *)malloc(size);
+	memcpy(file, data.begin(), size);
+	return file;
+}
+
+void runShortenBenchmark() {
+	for (int channels = 1; channels <= 2; channels++) {
+		uint32 size;
+		byte *data = createShortenFile(channels, 8000 / channels, size);
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+		measureStream(channels == 1 ? "Shorten mono" : "Shorten stereo", Saga::makeShortenStream(stream, DisposeAfterUse::YES), 5);
+	}
+}
+
+#endif
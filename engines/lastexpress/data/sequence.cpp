@@ -78,7 +78,7 @@ void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 
 AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _palette(NULL) {
 	_palSize = 1;
-	// TODO: use just the needed rectangle
+	// Decode to a full screen buffer, crop() then only keeps the visible part
 	_image.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
 
 	//debugC(6, kLastExpressDebugGraphics, "    Offsets: data=%d, unknown=%d, palette=%d", f.dataOffset, f.unknown, f.paletteOffset);
@@ -120,6 +120,8 @@ AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /*
 	readPalette(in, f);
 	_rect = Common::Rect((int16)f.xPos1, (int16)f.yPos1, (int16)f.xPos2, (int16)f.yPos2);
 	//_rect.debugPrint(0, "Frame rect:");
+
+	crop();
 }
 
 AnimFrame::~AnimFrame() {
@@ -128,15 +130,62 @@ AnimFrame::~AnimFrame() {
 }
 
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
-	byte *inp = (byte *)_image.getPixels();
-	uint16 *outp = (uint16 *)s->getPixels();
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
-		if (*inp)
-			*outp = _palette[*inp];
+	return draw(s, Common::Rect(640, 480));
+}
+
+Common::Rect AnimFrame::draw(Graphics::Surface *s, const Common::Rect &clip) {
+	Common::Rect area = _bounds;
+	area.clip(clip);
+	area.clip(Common::Rect(s->w, s->h));
+
+	for (int16 y = area.top; y < area.bottom; y++) {
+		const byte *inp = (const byte *)_image.getBasePtr(area.left - _bounds.left, y - _bounds.top);
+		uint16 *outp = (uint16 *)s->getBasePtr(area.left, y);
+		for (int16 x = area.left; x < area.right; x++, inp++, outp++) {
+			if (*inp)
+				*outp = _palette[*inp];
+		}
 	}
+
 	return _rect;
 }
 
+uint32 AnimFrame::getMemorySize() const {
+	return sizeof(AnimFrame) + _image.w * _image.h + _palSize * sizeof(uint16);
+}
+
+void AnimFrame::crop() {
+	// Find the area holding non-transparent pixels
+	int16 left = 640, top = 480, right = 0, bottom = 0;
+	for (int16 y = 0; y < 480; y++) {
+		const byte *p = (const byte *)_image.getBasePtr(0, y);
+		for (int16 x = 0; x < 640; x++) {
+			if (p[x]) {
+				left = MIN(left, x);
+				right = MAX<int16>(right, x + 1);
+				top = MIN(top, y);
+				bottom = y + 1;
+			}
+		}
+	}
+
+	if (left >= right) {
+		_bounds = Common::Rect();
+		_image.free();
+		return;
+	}
+
+	_bounds = Common::Rect(left, top, right, bottom);
+
+	Graphics::Surface cropped;
+	cropped.create(_bounds.width(), _bounds.height(), _image.format);
+	for (int16 y = 0; y < cropped.h; y++)
+		memcpy(cropped.getBasePtr(0, y), _image.getBasePtr(left, top + y), cropped.w);
+
+	_image.free();
+	_image = cropped;
+}
+
 void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f) {
 	// Read the palette
 	in->seek((int)f.paletteOffset);
@@ -338,11 +387,21 @@ Sequence::~Sequence() {
 }
 
 void Sequence::reset() {
+	clearFrameCache();
 	_frames.clear();
 	delete _stream;
 	_stream = NULL;
 }
 
+void Sequence::clearFrameCache() {
+	for (uint i = 0; i < _frameCache.size(); i++)
+		delete _frameCache[i];
+
+	_frameCache.clear();
+	_frameCacheOrder.clear();
+	_frameCacheSize = 0;
+}
+
 Sequence *Sequence::load(Common::String name, Common::SeekableReadStream *stream, byte field30) {
 	Sequence *sequence = new Sequence(name);
 
@@ -415,9 +474,36 @@ AnimFrame *Sequence::getFrame(uint16 index) {
 	if (frame->compressionType == 0)
 		return NULL;
 
+	if (_frameCache.empty())
+		_frameCache.resize(_frames.size());
+
+	// Move already decoded frames to the back of the LRU list
+	if (_frameCache[index]) {
+		if (_frameCacheOrder.back() != index) {
+			_frameCacheOrder.remove(index);
+			_frameCacheOrder.push_back(index);
+		}
+		return _frameCache[index];
+	}
+
 	debugC(9, kLastExpressDebugGraphics, "Decoding sequence %s: frame %d / %d", _name.c_str(), index, _frames.size() - 1);
 
-	return new AnimFrame(_stream, *frame);
+	AnimFrame *animFrame = new AnimFrame(_stream, *frame);
+
+	// Make room for the new frame by dropping the least recently used ones
+	while (!_frameCacheOrder.empty() && _frameCacheSize + animFrame->getMemorySize() > _frameCacheBudget) {
+		uint16 oldest = _frameCacheOrder.front();
+		_frameCacheOrder.pop_front();
+		_frameCacheSize -= _frameCache[oldest]->getMemorySize();
+		delete _frameCache[oldest];
+		_frameCache[oldest] = NULL;
+	}
+
+	_frameCache[index] = animFrame;
+	_frameCacheOrder.push_back(index);
+	_frameCacheSize += animFrame->getMemorySize();
+
+	return animFrame;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -438,11 +524,29 @@ Common::Rect SequenceFrame::draw(Graphics::Surface *surface) {
 	if (!f)
 		return Common::Rect();
 
-	Common::Rect rect = f->draw(surface);
+	return f->draw(surface);
+}
+
+Common::Rect SequenceFrame::draw(Graphics::Surface *surface, const Common::Rect &clip) {
+	if (!_sequence || _frame >= _sequence->count())
+		return Common::Rect();
+
+	AnimFrame *f = _sequence->getFrame(_frame);
+	if (!f)
+		return Common::Rect();
+
+	return f->draw(surface, clip);
+}
 
-	delete f;
+Common::Rect SequenceFrame::getBounds() {
+	if (!_sequence || _frame >= _sequence->count())
+		return Common::Rect();
+
+	AnimFrame *f = _sequence->getFrame(_frame);
+	if (!f)
+		return Common::Rect();
 
-	return rect;
+	return f->getBounds();
 }
 
 bool SequenceFrame::setFrame(uint16 frame) {
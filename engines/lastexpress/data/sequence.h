@@ -75,6 +75,7 @@
 #include "lastexpress/shared.h"
 
 #include "common/array.h"
+#include "common/list.h"
 #include "common/rect.h"
 #include "common/str.h"
 
@@ -133,6 +134,11 @@ public:
 	AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool ignoreSubtype = false);
 	~AnimFrame();
 	Common::Rect draw(Graphics::Surface *s);
+	Common::Rect draw(Graphics::Surface *s, const Common::Rect &clip);
+
+	/** Area covered by the non-transparent pixels of the frame */
+	const Common::Rect &getBounds() const { return _bounds; }
+	uint32 getMemorySize() const;
 
 private:
 	void decomp3(Common::SeekableReadStream *in, const FrameInfo &f);
@@ -142,16 +148,18 @@ private:
 	void decomp7(Common::SeekableReadStream *in, const FrameInfo &f);
 	void decompFF(Common::SeekableReadStream *in, const FrameInfo &f);
 	void readPalette(Common::SeekableReadStream *in, const FrameInfo &f);
+	void crop();
 
-	Graphics::Surface _image;
+	Graphics::Surface _image;     ///< Decoded pixels, only covering _bounds
 	uint16 _palSize;
 	uint16 *_palette;
 	Common::Rect _rect;
+	Common::Rect _bounds;
 };
 
 class Sequence {
 public:
-	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15) {}
+	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _frameCacheSize(0), _name(name), _field30(15) {}
 	~Sequence();
 
 	static Sequence *load(Common::String name, Common::SeekableReadStream *stream = NULL, byte field30 = 15);
@@ -159,6 +167,15 @@ public:
 	bool load(Common::SeekableReadStream *stream, byte field30 = 15);
 
 	uint16 count() const { return (uint16)_frames.size(); }
+
+	/**
+	 * Get a decoded frame.
+	 *
+	 * Frames are kept decoded until the sequence is unloaded or the
+	 * decoded frames exceed the cache budget, so the returned frame is
+	 * owned by the sequence and must not be deleted. It stays valid until
+	 * the next call.
+	 */
 	AnimFrame *getFrame(uint16 index = 0);
 	FrameInfo *getFrameInfo(uint16 index = 0);
 
@@ -170,13 +187,21 @@ public:
 private:
 	static const uint32 _sequenceHeaderSize = 8;
 	static const uint32 _sequenceFrameSize = 68;
+	static const uint32 _frameCacheBudget = 1024 * 1024;
 
 	void reset();
+	void clearFrameCache();
 
 	Common::Array<FrameInfo> _frames;
 	Common::SeekableReadStream *_stream;
 	bool _isLoaded;
 
+	// Decoded frames, indexed like _frames, and the cached frame indices
+	// from least to most recently used
+	Common::Array<AnimFrame *> _frameCache;
+	Common::List<uint16> _frameCacheOrder;
+	uint32 _frameCacheSize;
+
 	Common::String _name;
 	byte _field30; // used when copying sequences
 };
@@ -187,6 +212,10 @@ public:
 	~SequenceFrame();
 
 	Common::Rect draw(Graphics::Surface *surface);
+	Common::Rect draw(Graphics::Surface *surface, const Common::Rect &clip);
+
+	/** Area covered by the non-transparent pixels of the current frame */
+	Common::Rect getBounds();
 
 	bool setFrame(uint16 frame);
 	uint32 getFrame() { return _frame; }
@@ -652,10 +652,43 @@ void SceneManager::drawFrames(bool refreshScreen) {
 
 	// TODO handle flag coordinates
 
-	clearBg(GraphicsManager::kBackgroundOverlay);
+	GraphicsManager *graphics = _engine->getGraphicsManager();
 
-	for (Common::List<SequenceFrame *>::iterator i = _queue.begin(); i != _queue.end(); ++i)
-		_engine->getGraphicsManager()->draw(*i, GraphicsManager::kBackgroundOverlay);
+	// Something else has been drawn to the overlay or it has been cleared,
+	// so we cannot rely on the previously drawn frames being there
+	if (graphics->isOverlayChanged()) {
+		for (Common::Array<QueueEntry>::iterator i = _queue.begin(); i != _queue.end(); ++i)
+			i->drawn = false;
+
+		invalidate(Common::Rect(640, 480));
+	}
+
+	// Frames which changed since they were last drawn need both their old
+	// and their new area redrawn
+	for (Common::Array<QueueEntry>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+		if (i->drawn && i->index == i->frame->getFrame())
+			continue;
+
+		if (i->drawn)
+			invalidate(i->rect);
+
+		i->index = (uint16)i->frame->getFrame();
+		i->rect = i->frame->getBounds();
+		i->drawn = true;
+		invalidate(i->rect);
+	}
+
+	if (!_dirtyRect.isEmpty()) {
+		graphics->clear(GraphicsManager::kBackgroundOverlay, _dirtyRect);
+
+		for (Common::Array<QueueEntry>::iterator i = _queue.begin(); i != _queue.end(); ++i)
+			if (i->rect.intersects(_dirtyRect))
+				graphics->draw(i->frame, GraphicsManager::kBackgroundOverlay, _dirtyRect);
+
+		_dirtyRect = Common::Rect();
+	}
+
+	graphics->resetOverlayChanged();
 
 	if (refreshScreen) {
 		askForRedraw();
@@ -670,8 +703,8 @@ void SceneManager::addToQueue(SequenceFrame * const frame) {
 		return;
 
 	// First check that the frame is not already in the queue
-	for (Common::List<SequenceFrame *>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
-		if (frame->equal(*i))
+	for (Common::Array<QueueEntry>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+		if (frame->equal(i->frame))
 			return;
 	}
 
@@ -680,28 +713,17 @@ void SceneManager::addToQueue(SequenceFrame * const frame) {
 	// Set flag
 	_flagDrawSequences = true;
 
-	// Queue empty: just insert the frame
-	if (_queue.empty()) {
-		_queue.push_back(frame);
-		return;
-	}
-
-	// Frame is closer: insert in first place
-	if (frame->getInfo()->location > _queue.front()->getInfo()->location) {
-		_queue.push_front(frame);
-		return;
-	}
-
-	// Insert the frame in the queue based on location
-	for (Common::List<SequenceFrame *>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
-		if (frame->getInfo()->location > (*i)->getInfo()->location) {
-			_queue.insert(i, frame);
+	// Insert the frame in the queue based on location, after the frames
+	// with the same location
+	for (uint i = 0; i < _queue.size(); i++) {
+		if (frame->getInfo()->location > _queue[i].frame->getInfo()->location) {
+			_queue.insert_at(i, QueueEntry(frame));
 			return;
 		}
 	}
 
 	// We are the last frame in location order, insert at the back of the queue
-	_queue.push_back(frame);
+	_queue.push_back(QueueEntry(frame));
 }
 
 void SceneManager::removeFromQueue(SequenceFrame *frame) {
@@ -711,9 +733,12 @@ void SceneManager::removeFromQueue(SequenceFrame *frame) {
 	debugC(8, kLastExpressDebugGraphics, "Removing frame: %s / %d", frame->getName().c_str(), frame->getFrame());
 
 	// Check that the frame is in the queue and remove it
-	for (Common::List<SequenceFrame *>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
-		if (frame->equal(*i)) {
-			_queue.erase(i);
+	for (uint i = 0; i < _queue.size(); i++) {
+		if (frame->equal(_queue[i].frame)) {
+			if (_queue[i].drawn)
+				invalidate(_queue[i].rect);
+
+			_queue.remove_at(i);
 			_flagDrawSequences = true;
 			break;
 		}
@@ -736,9 +761,23 @@ void SceneManager::resetQueue() {
 	_flagDrawSequences = true;
 
 	// The original engine only deletes decompressed data, not the "sequences" since they are just pointers to a memory pool
+	for (Common::Array<QueueEntry>::iterator i = _queue.begin(); i != _queue.end(); ++i)
+		if (i->drawn)
+			invalidate(i->rect);
+
 	_queue.clear();
 }
 
+void SceneManager::invalidate(const Common::Rect &rect) {
+	if (rect.isEmpty())
+		return;
+
+	if (_dirtyRect.isEmpty())
+		_dirtyRect = rect;
+	else
+		_dirtyRect.extend(rect);
+}
+
 void SceneManager::setCoordinates(const Common::Rect &rect) {
 	_flagCoordinates = true;
 
@@ -25,6 +25,7 @@
 
 #include "lastexpress/data/scene.h"
 
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/list.h"
 
@@ -103,14 +104,25 @@ private:
 	SequenceFrame *_clockHours;
 	SequenceFrame *_clockMinutes;
 
-	// Sequence queue
-	Common::List<SequenceFrame *> _queue;
+	// Sequence queue, sorted by location (back to front)
+	struct QueueEntry {
+		SequenceFrame *frame;
+		uint16 index;       ///< Frame index when the entry was last drawn
+		Common::Rect rect;  ///< Area covered when the entry was last drawn
+		bool drawn;
+
+		QueueEntry(SequenceFrame *f) : frame(f), index(0), drawn(false) {}
+	};
+
+	Common::Array<QueueEntry> _queue;
+	Common::Rect _dirtyRect;            ///< Part of the overlay which needs to be redrawn
 
 	// Scene processing
 	void preProcessScene(SceneIndex *index);
 	void postProcessScene();
 
 	void resetCoordinates();
+	void invalidate(const Common::Rect &rect);
 };
 
 } // End of namespace LastExpress
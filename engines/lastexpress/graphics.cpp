@@ -22,6 +22,8 @@
 
 #include "lastexpress/graphics.h"
 
+#include "lastexpress/data/sequence.h"
+
 #include "common/rect.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -30,7 +32,7 @@ namespace LastExpress {
 
 #define COLOR_KEY  0xFFFF
 
-GraphicsManager::GraphicsManager() : _changed(false) {
+GraphicsManager::GraphicsManager() : _changed(false), _overlayChanged(true) {
 	const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
 	_screen.create(640, 480, format);
 
@@ -70,6 +72,9 @@ void GraphicsManager::clear(BackgroundType type) {
 }
 
 void GraphicsManager::clear(BackgroundType type, const Common::Rect &rect) {
+	if (type == kBackgroundOverlay || type == kBackgroundAll)
+		_overlayChanged = true;
+
 	switch (type) {
 		default:
 			error("[GraphicsManager::clear] Unknown background type: %d", type);
@@ -96,12 +101,22 @@ bool GraphicsManager::draw(Drawable *drawable, BackgroundType type, bool transit
 	if (transition)
 		clear(type);
 
+	if (type == kBackgroundOverlay)
+		_overlayChanged = true;
+
 	// TODO store rect for later use
 	Common::Rect rect = drawable->draw(getSurface(type));
 
 	return (!rect.isEmpty());
 }
 
+void GraphicsManager::draw(SequenceFrame *frame, BackgroundType type, const Common::Rect &clip) {
+	if (type == kBackgroundOverlay)
+		_overlayChanged = true;
+
+	frame->draw(getSurface(type), clip);
+}
+
 Graphics::Surface *GraphicsManager::getSurface(BackgroundType type) {
 	switch (type) {
 		default:
@@ -27,6 +27,8 @@
 
 namespace LastExpress {
 
+class SequenceFrame;
+
 class GraphicsManager {
 public:
 	enum BackgroundType {
@@ -55,6 +57,14 @@ public:
 
 	bool draw(Drawable *drawable, BackgroundType type, bool transition = false);
 
+	// Draw the part of a sequence frame inside the clipping rectangle
+	void draw(SequenceFrame *frame, BackgroundType type, const Common::Rect &clip);
+
+	// Check whether the overlay has been cleared or drawn on through
+	// clear() or draw() since the last call to resetOverlayChanged()
+	bool isOverlayChanged() const { return _overlayChanged; }
+	void resetOverlayChanged() { _overlayChanged = false; }
+
 private:
 	Graphics::Surface _backgroundA; // Background A
 	Graphics::Surface _backgroundC; // Background C
@@ -66,6 +76,7 @@ private:
 	Graphics::Surface *getSurface(BackgroundType type);
 
 	bool _changed;
+	bool _overlayChanged;
 };
 
 } // End of namespace LastExpress
@@ -24,6 +24,7 @@
 #include "mohawk/resource.h"
 #include "mohawk/graphics.h"
 
+#include "common/debug.h"
 #include "common/system.h"
 #include "engines/util.h"
 #include "graphics/palette.h"
@@ -68,7 +69,24 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
+uint32 MohawkSurface::getMemorySize() const {
+	uint32 size = sizeof(MohawkSurface);
+
+	if (_surface)
+		size += _surface->pitch * _surface->h;
+
+	if (_palette)
+		size += 256 * 3;
+
+	return size;
+}
+
+// Enough for roughly the current card and its neighbours in Riven
+static const uint32 kDefaultImageCacheBudget = 32 * 1024 * 1024;
+
 GraphicsManager::GraphicsManager() {
+	_cacheSize = 0;
+	_cacheBudget = kDefaultImageCacheBudget;
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -76,28 +94,82 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CacheEntry>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
+
+	_cache.clear();
+	_lruList.clear();
+	_cacheSize = 0;
+	clearSubImageCache();
+	_prefetchQueue.clear();
+}
+
+void GraphicsManager::clearSubImageCache() {
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
 			delete array[i];
 	}
 
-	_cache.clear();
 	_subImageCache.clear();
 }
 
+void GraphicsManager::trimCache() {
+	// Sub-images are not accounted for in the budget, so they are
+	// only kept until the next card change, as before.
+	clearSubImageCache();
+
+	while (_cacheSize > _cacheBudget && !_lruList.empty()) {
+		uint16 id = _lruList.back();
+		_lruList.pop_back();
+
+		CacheEntry &entry = _cache[id];
+		_cacheSize -= entry.size;
+		delete entry.surface;
+		_cache.erase(id);
+	}
+}
+
+void GraphicsManager::setCacheBudget(uint32 budget) {
+	_cacheBudget = budget;
+	trimCache();
+}
+
+void GraphicsManager::insertIntoCache(uint16 id, MohawkSurface *surface, bool used) {
+	CacheEntry entry;
+	entry.surface = surface;
+	entry.size = surface->getMemorySize();
+
+	if (used) {
+		_lruList.push_front(id);
+		entry.lruPos = _lruList.begin();
+	} else {
+		_lruList.push_back(id);
+		entry.lruPos = _lruList.reverse_begin();
+	}
+
+	_cache[id] = entry;
+
+	_cacheSize += entry.size;
+}
+
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+	Common::HashMap<uint16, CacheEntry>::iterator it = _cache.find(id);
+
+	if (it == _cache.end()) {
+		// Nothing is evicted here: callers may still hold surfaces returned
+		// by earlier lookups. The cache is trimmed on card changes instead.
+		MohawkSurface *surface = decodeImage(id);
+		insertIntoCache(id, surface);
+		return surface;
+	}
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	// Move the image to the front of the LRU list
+	_lruList.erase(it->_value.lruPos);
+	_lruList.push_front(id);
+	it->_value.lruPos = _lruList.begin();
 
-	return _cache[id];
+	return it->_value.surface;
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -108,6 +180,39 @@ void GraphicsManager::preloadImage(uint16 image) {
 	findImage(image);
 }
 
+void GraphicsManager::schedulePrefetch(uint16 image) {
+	_prefetchQueue.push(image);
+}
+
+void GraphicsManager::clearPrefetchQueue() {
+	_prefetchQueue.clear();
+}
+
+bool GraphicsManager::runPrefetch() {
+	while (!_prefetchQueue.empty()) {
+		uint16 id = _prefetchQueue.pop();
+
+		if (_cache.contains(id) || !canPrefetchImage(id))
+			continue;
+
+		// Don't push the images of the current card out of the cache
+		if (_cacheSize >= _cacheBudget) {
+			_prefetchQueue.clear();
+			return false;
+		}
+
+		debug(4, "Prefetching image %d", id);
+		MohawkSurface *surface = decodeImage(id);
+
+		// Prefetched images have not been used yet, so they are the
+		// first candidates for eviction.
+		insertIntoCache(id, surface, false);
+		return true;
+	}
+
+	return false;
+}
+
 void GraphicsManager::setPalette(uint16 id) {
 	Common::SeekableReadStream *tpalStream = getVM()->getResource(ID_TPAL, id);
 
@@ -227,7 +332,7 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	insertIntoCache(id, surface);
 }
 
 } // End of namespace Mohawk
@@ -26,6 +26,8 @@
 #include "mohawk/bitmap.h"
 
 #include "common/hashmap.h"
+#include "common/list.h"
+#include "common/queue.h"
 #include "common/rect.h"
 
 namespace Graphics {
@@ -60,6 +62,9 @@ public:
 	void setOffsetX(int x) { _offsetX = x; }
 	void setOffsetY(int y) { _offsetY = y; }
 
+	// Approximate amount of memory used by the decoded image
+	uint32 getMemorySize() const;
+
 private:
 	Graphics::Surface *_surface;
 	byte *_palette;
@@ -74,6 +79,18 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Free the least recently used surfaces until the cache fits its budget,
+	// and all sub-images
+	void trimCache();
+	void setCacheBudget(uint32 budget);
+	uint32 getCacheSize() const { return _cacheSize; }
+
+	// Queue an image for decoding while the engine is idle
+	void schedulePrefetch(uint16 image);
+	void clearPrefetchQueue();
+	// Decode at most one queued image. Returns false when there is nothing to do.
+	bool runPrefetch();
+
 	void preloadImage(uint16 image);
 	virtual void setPalette(uint16 id);
 	void copyAnimImageToScreen(uint16 image, int left = 0, int top = 0);
@@ -96,9 +113,31 @@ protected:
 	virtual MohawkEngine *getVM() = 0;
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
+	// Returns false if the image does not exist in the currently loaded files
+	virtual bool canPrefetchImage(uint16 id) { return false; }
+
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	// An image cache that stores decoded images in least recently used order.
+	// Surfaces are only freed by trimCache() and clearCache(), so a pointer
+	// returned by findImage() stays valid until the next card change.
+	typedef Common::List<uint16> LRUList;
+
+	struct CacheEntry {
+		MohawkSurface *surface;
+		uint32 size;
+		LRUList::iterator lruPos;
+	};
+
+	void insertIntoCache(uint16 id, MohawkSurface *surface, bool used = true);
+	void clearSubImageCache();
+
+	Common::HashMap<uint16, CacheEntry> _cache;
+	LRUList _lruList;
+	uint32 _cacheSize;
+	uint32 _cacheBudget;
+
+	Common::Queue<uint16> _prefetchQueue;
+
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
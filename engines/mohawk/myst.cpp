@@ -363,6 +363,9 @@ Common::Error MohawkEngine_Myst::run() {
 		if (_needsUpdate) {
 			_system->updateScreen();
 			_needsUpdate = false;
+		} else {
+			// Decode the images of neighbouring cards while idle
+			_gfx->runPrefetch();
 		}
 
 		// Cut down on CPU usage
@@ -565,9 +568,11 @@ void MohawkEngine_Myst::changeToCard(uint16 card, TransitionType transition) {
 
 	unloadCard();
 
-	// Clear the resource cache and image cache
+	// Clear the resource cache, and drop the least recently used images
+	// if the image cache got too large. Images of neighbouring cards are
+	// kept so that going back and forth between cards is fast.
 	_cache.clear();
-	_gfx->clearCache();
+	_gfx->trimCache();
 
 	_curCard = card;
 
@@ -646,6 +651,36 @@ void MohawkEngine_Myst::changeToCard(uint16 card, TransitionType transition) {
 	// Debug: Show resource rects
 	if (_showResourceRects)
 		drawResourceRects();
+
+	prefetchNeighbourCards();
+}
+
+void MohawkEngine_Myst::prefetchNeighbourCards() {
+	_gfx->clearPrefetchQueue();
+
+	for (uint16 i = 0; i < _resources.size(); i++) {
+		uint16 dest = _resources[i]->getDest();
+		if (dest == 0 || dest == _curCard || !hasResource(ID_VIEW, dest))
+			continue;
+
+		// Read the image block of the destination card's view
+		Common::SeekableReadStream *viewStream = getResource(ID_VIEW, dest);
+		viewStream->readUint16LE(); // flags
+
+		uint16 conditionalImageCount = viewStream->readUint16LE();
+		if (conditionalImageCount != 0) {
+			for (uint16 j = 0; j < conditionalImageCount; j++) {
+				viewStream->readUint16LE(); // var
+				uint16 numStates = viewStream->readUint16LE();
+				for (uint16 k = 0; k < numStates; k++)
+					_gfx->schedulePrefetch(viewStream->readUint16LE());
+			}
+		} else {
+			_gfx->schedulePrefetch(viewStream->readUint16LE());
+		}
+
+		delete viewStream;
+	}
 }
 
 void MohawkEngine_Myst::drawResourceRects() {
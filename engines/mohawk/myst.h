@@ -237,6 +237,7 @@ private:
 	void loadHelp(uint16 id);
 
 	void loadResources();
+	void prefetchNeighbourCards();
 	void drawResourceRects();
 	void checkCurrentResource();
 	int16 _curResource;
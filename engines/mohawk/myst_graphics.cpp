@@ -108,6 +108,10 @@ MohawkSurface *MystGraphics::decodeImage(uint16 id) {
 	return mhkSurface;
 }
 
+bool MystGraphics::canPrefetchImage(uint16 id) {
+	return _vm->hasResource(ID_WDIB, id) || (_vm->getFeatures() & GF_ME && _vm->hasResource(ID_PICT, id));
+}
+
 void MystGraphics::copyImageSectionToScreen(uint16 image, Common::Rect src, Common::Rect dest) {
 	Graphics::Surface *surface = findImage(image)->getSurface();
 
@@ -40,8 +40,9 @@ void ResourceCache::clear() {
 
 	debugC(kDebugCache, "Clearing Cache...");
 
-	for (uint32 i = 0; i < _store.size(); i++)
-		delete _store[i].data;
+	for (TypeMap::iterator it = _store.begin(); it != _store.end(); it++)
+		for (ResourceMap::iterator it2 = it->_value.begin(); it2 != it->_value.end(); it2++)
+			delete it2->_value;
 
 	_store.clear();
 }
@@ -50,15 +51,17 @@ void ResourceCache::add(uint32 tag, uint16 id, Common::SeekableReadStream *data)
 	if (!enabled)
 		return;
 
-	debugC(kDebugCache, "Adding item %d - tag 0x%04X id %d", _store.size(), tag, id);
+	debugC(kDebugCache, "Adding item - tag 0x%04X id %d", tag, id);
+
+	ResourceMap &resMap = _store[tag];
+
+	// Replace any previous copy of this resource
+	if (resMap.contains(id))
+		delete resMap[id];
 
-	DataObject current;
-	current.tag = tag;
-	current.id = id;
 	uint32 dataCurPos = data->pos();
-	current.data = data->readStream(data->size());
+	resMap[id] = data->readStream(data->size());
 	data->seek(dataCurPos);
-	_store.push_back(current);
 }
 
 // Returns NULL if not found
@@ -68,12 +71,15 @@ Common::SeekableReadStream *ResourceCache::search(uint32 tag, uint16 id) {
 
 	debugC(kDebugCache, "Searching for tag 0x%04X id %d", tag, id);
 
-	for (uint32 i = 0; i < _store.size(); i++) {
-		if (tag == _store[i].tag && id == _store[i].id) {
+	TypeMap::iterator typeIt = _store.find(tag);
+	if (typeIt != _store.end()) {
+		ResourceMap::iterator resIt = typeIt->_value.find(id);
+		if (resIt != typeIt->_value.end()) {
 			debugC(kDebugCache, "Found cached tag 0x%04X id %u", tag, id);
-			uint32 dataCurPos  = _store[i].data->pos();
-			Common::SeekableReadStream *ret = _store[i].data->readStream(_store[i].data->size());
-			_store[i].data->seek(dataCurPos);
+			Common::SeekableReadStream *data = resIt->_value;
+			uint32 dataCurPos = data->pos();
+			Common::SeekableReadStream *ret = data->readStream(data->size());
+			data->seek(dataCurPos);
 			return ret;
 		}
 	}
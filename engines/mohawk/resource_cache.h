@@ -23,7 +23,7 @@
 #ifndef RESOURCE_CACHE_H
 #define RESOURCE_CACHE_H
 
-#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/stream.h"
 
 namespace Mohawk {
@@ -42,13 +42,9 @@ public:
 	Common::SeekableReadStream *search(uint32 tag, uint16 id);
 
 private:
-	struct DataObject {
-		uint32 tag;
-		uint16 id;
-		Common::SeekableReadStream *data;
-	};
-
-	Common::Array<DataObject> _store;
+	typedef Common::HashMap<uint16, Common::SeekableReadStream *> ResourceMap;
+	typedef Common::HashMap<uint32, ResourceMap> TypeMap;
+	TypeMap _store;
 };
 
 } // End of namespace Mohawk
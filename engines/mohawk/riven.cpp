@@ -283,6 +283,8 @@ void MohawkEngine_Riven::handleEvents() {
 	// Update the screen if we need to
 	if (needsUpdate)
 		_system->updateScreen();
+	else
+		_gfx->runPrefetch(); // Decode the images of neighbouring cards while idle
 
 	// Cut down on CPU usage
 	_system->delayMillis(10);
@@ -365,9 +367,10 @@ void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	_curCard = dest;
 	debug (1, "Changing to card %d", _curCard);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// Drop the least recently used images if the cache got too large.
+	// Images of neighbouring cards are kept so that going back and
+	// forth between cards doesn't decode them again.
+	_gfx->trimCache();
 
 	if (!(getFeatures() & GF_DEMO)) {
 		for (byte i = 0; i < 13; i++)
@@ -414,6 +417,36 @@ void MohawkEngine_Riven::refreshCard() {
 
 	// Finally, install any hardcoded timer
 	installCardTimer();
+
+	prefetchNeighbourCards();
+}
+
+void MohawkEngine_Riven::prefetchNeighbourCards() {
+	_gfx->clearPrefetchQueue();
+
+	// Find the cards the player can go to from this one
+	Common::Array<uint16> cards;
+	for (uint16 i = 0; i < _hotspotCount; i++)
+		if (_hotspots[i].enabled)
+			for (uint32 j = 0; j < _hotspots[i].scripts.size(); j++)
+				_hotspots[i].scripts[j]->findCardSwitches(cards);
+
+	// And queue the images of their picture lists for decoding
+	for (uint32 i = 0; i < cards.size(); i++) {
+		if (cards[i] == _curCard || !hasResource(ID_PLST, cards[i]))
+			continue;
+
+		Common::SeekableReadStream *plst = getResource(ID_PLST, cards[i]);
+		uint16 recordCount = plst->readUint16BE();
+
+		for (uint16 j = 0; j < recordCount; j++) {
+			plst->readUint16BE(); // index
+			_gfx->schedulePrefetch(plst->readUint16BE());
+			plst->skip(8); // rect
+		}
+
+		delete plst;
+	}
 }
 
 void MohawkEngine_Riven::loadCard(uint16 id) {
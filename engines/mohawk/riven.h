@@ -180,6 +180,7 @@ public:
 	void changeToCard(uint16 dest);
 	void changeToStack(uint16);
 	void refreshCard();
+	void prefetchNeighbourCards();
 	Common::String getName(uint16 nameResource, uint16 nameID);
 	Common::String getStackName(uint16 stack) const;
 	void runCardScript(uint16 scriptType);
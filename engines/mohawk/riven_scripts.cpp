@@ -85,6 +85,43 @@ uint32 RivenScript::calculateScriptSize(Common::SeekableReadStream* script) {
 	return scriptSize;
 }
 
+void RivenScript::findCardSwitches(Common::Array<uint16> &cards) {
+	uint32 oldPos = _stream->pos();
+	_stream->seek(0);
+	findCardSwitches(_stream, cards);
+	_stream->seek(oldPos);
+}
+
+void RivenScript::findCardSwitches(Common::SeekableReadStream *script, Common::Array<uint16> &cards) {
+	uint16 commandCount = script->readUint16BE();
+
+	for (uint16 i = 0; i < commandCount && script->pos() < script->size(); i++) {
+		uint16 command = script->readUint16BE();
+
+		if (command == 8) {
+			script->readUint16BE(); // Arg count
+			script->readUint16BE(); // variable to check against
+			uint16 logicBlockCount = script->readUint16BE();
+
+			// Follow all the branches, we don't know which one will be taken
+			for (uint16 j = 0; j < logicBlockCount; j++) {
+				script->readUint16BE(); // Block variable
+				findCardSwitches(script, cards);
+			}
+		} else {
+			uint16 argCount = script->readUint16BE();
+
+			for (uint16 j = 0; j < argCount; j++) {
+				uint16 arg = script->readUint16BE();
+
+				// Command 2: go to card (card id)
+				if (command == 2 && j == 0 && Common::find(cards.begin(), cards.end(), arg) == cards.end())
+					cards.push_back(arg);
+			}
+		}
+	}
+}
+
 #define OPCODE(x) { &RivenScript::x, #x }
 
 void RivenScript::setupOpcodes() {
@@ -66,6 +66,9 @@ public:
 
 	static uint32 calculateScriptSize(Common::SeekableReadStream *script);
 
+	// Append the destinations of the card switch commands to cards
+	void findCardSwitches(Common::Array<uint16> &cards);
+
 private:
 	typedef void (RivenScript::*OpcodeProcRiven)(uint16 op, uint16 argc, uint16 *argv);
 	struct RivenOpcode {
@@ -84,6 +87,7 @@ private:
 	void processCommands(bool runCommands);
 
 	static uint32 calculateCommandSize(Common::SeekableReadStream *script);
+	static void findCardSwitches(Common::SeekableReadStream *script, Common::Array<uint16> &cards);
 
 	DECLARE_OPCODE(empty) { warning ("Unknown Opcode %04x", op); }
 
@@ -93,7 +93,7 @@ static const int16 directions[8][2] = {
 	{	0,		16}
 };
 
-IsoMap::IsoMap(SagaEngine *vm) : _vm(vm) {
+IsoMap::IsoMap(SagaEngine *vm) : _vm(vm), _staticLayerValid(false) {
 	_viewScroll.x = (128 - 8) * 16;
 	_viewScroll.y = (128 - 8) * 16 - 64;
 	_viewDiff = 1;
@@ -137,6 +137,55 @@ void IsoMap::loadImages(const ByteArray &resourceData) {
 	for (i = 0; i < _tilesTable.size(); i++) {
 		_tilesTable[i].tilePointer = _tileData.getBuffer() + tempOffsets[i] - offsetDiff;
 	}
+
+	// Index where each row of the tiles starts, so that drawTile() can skip
+	// the rows above the clipping area without decoding them
+	const byte *tileDataEnd = _tileData.getBuffer() + _tileData.size();
+	_tileRowOffsets.clear();
+	for (i = 0; i < _tilesTable.size(); i++) {
+		tileData = &_tilesTable[i];
+		tileData->rowIndex = -1;
+
+		// drawTile() does not draw these
+		if ((tileData->height <= 8) || (tileData->height > 64)) {
+			continue;
+		}
+
+		const byte *readPointer = tileData->tilePointer;
+		uint32 firstRow = _tileRowOffsets.size();
+		bool valid = (readPointer >= _tileData.getBuffer());
+
+		for (int row = 0; valid && row < tileData->height; row++) {
+			_tileRowOffsets.push_back(readPointer - tileData->tilePointer);
+
+			int widthCount = 0;
+			for (;;) {
+				if (readPointer >= tileDataEnd) {
+					valid = false;
+					break;
+				}
+				widthCount += *readPointer++;
+				if (widthCount >= SAGA_ISOTILE_WIDTH) {
+					break;
+				}
+				if (readPointer >= tileDataEnd) {
+					valid = false;
+					break;
+				}
+				int fgRunCount = *readPointer++;
+				widthCount += fgRunCount;
+				readPointer += fgRunCount;
+			}
+		}
+
+		if (valid) {
+			tileData->rowIndex = firstRow;
+		} else {
+			_tileRowOffsets.resize(firstRow);
+		}
+	}
+
+	_staticLayerValid = false;
 }
 
 void IsoMap::loadPlatforms(const ByteArray &resourceData) {
@@ -166,6 +215,7 @@ void IsoMap::loadPlatforms(const ByteArray &resourceData) {
 		}
 	}
 
+	_staticLayerValid = false;
 }
 
 void IsoMap::loadMap(const ByteArray &resourceData) {
@@ -185,6 +235,7 @@ void IsoMap::loadMap(const ByteArray &resourceData) {
 		}
 	}
 
+	_staticLayerValid = false;
 }
 
 void IsoMap::loadMetaTiles(const ByteArray &resourceData) {
@@ -207,6 +258,8 @@ void IsoMap::loadMetaTiles(const ByteArray &resourceData) {
 			metaTileData->stack[j] = readS.readSint16();
 		}
 	}
+
+	_staticLayerValid = false;
 }
 
 void IsoMap::loadMulti(const ByteArray &resourceData) {
@@ -248,6 +301,8 @@ void IsoMap::loadMulti(const ByteArray &resourceData) {
 	for (i = 0; i < _multiTableData.size(); i++) {
 		_multiTableData[i] = readS.readSint16();
 	}
+
+	_staticLayerValid = false;
 }
 
 void IsoMap::clear() {
@@ -256,7 +311,10 @@ void IsoMap::clear() {
 	_metaTileList.clear();
 	_multiTable.clear();
 	_tileData.clear();
+	_tileRowOffsets.clear();
 	_multiTableData.clear();
+
+	_staticLayerValid = false;
 }
 
 void IsoMap::adjustScroll(bool jump) {
@@ -360,9 +418,77 @@ int16 IsoMap::findMulti(int16 tileIndex, int16 absU, int16 absV, int16 absH) {
 }
 
 void IsoMap::draw() {
-	_tileClip = _vm->_scene->getSceneClip();
-	_vm->_gfx->drawRect(_tileClip, 0);
-	drawTiles(NULL);
+	Rect sceneClip = _vm->_scene->getSceneClip();
+	sceneClip.clip(Rect(_vm->_gfx->getBackBufferWidth(), _vm->_gfx->getBackBufferHeight()));
+
+	int16 scrollX = _viewScroll.x - _staticLayerScroll.x;
+	int16 scrollY = _viewScroll.y - _staticLayerScroll.y;
+
+	if (_staticLayerValid && _staticLayerClip == sceneClip &&
+		ABS(scrollX) < sceneClip.width() && ABS(scrollY) < sceneClip.height()) {
+		drawScrolledTiles(sceneClip, scrollX, scrollY);
+	} else {
+		_tileClip = sceneClip;
+		_vm->_gfx->drawRect(_tileClip, 0);
+		drawTiles(NULL);
+	}
+
+	// Keep the tiles for the next frame
+	const int width = sceneClip.width();
+	_staticLayer.resize(width * sceneClip.height());
+	for (int y = sceneClip.top; y < sceneClip.bottom; y++) {
+		const byte *src = _vm->_gfx->getBackBufferPixels() + y * _vm->_gfx->getBackBufferPitch() + sceneClip.left;
+		memcpy(_staticLayer.getBuffer() + (y - sceneClip.top) * width, src, width);
+	}
+
+	_staticLayerScroll = _viewScroll;
+	_staticLayerClip = sceneClip;
+	_staticLayerValid = true;
+	_tileClip = sceneClip;
+}
+
+void IsoMap::drawScrolledTiles(const Rect &sceneClip, int16 scrollX, int16 scrollY) {
+	const int width = sceneClip.width();
+	const int height = sceneClip.height();
+
+	// Move the part of the previous frame which is still visible. Pixel
+	// (x, y) of the new frame is pixel (x + scrollX, y + scrollY) of the
+	// previous one.
+	const int srcX = MAX<int>(scrollX, 0);
+	const int dstX = MAX<int>(-scrollX, 0);
+	const int copyWidth = width - ABS(scrollX);
+	const int srcY = MAX<int>(scrollY, 0);
+	const int dstY = MAX<int>(-scrollY, 0);
+	const int copyHeight = height - ABS(scrollY);
+
+	for (int y = 0; y < copyHeight; y++) {
+		byte *dst = _vm->_gfx->getBackBufferPixels() + (sceneClip.top + dstY + y) * _vm->_gfx->getBackBufferPitch() + sceneClip.left + dstX;
+		memcpy(dst, _staticLayer.getBuffer() + (srcY + y) * width + srcX, copyWidth);
+	}
+	_vm->_render->addDirtyRect(sceneClip);
+
+	// Only draw the tiles of the areas which scrolled into view
+	if (scrollX != 0) {
+		_tileClip = sceneClip;
+		if (scrollX > 0) {
+			_tileClip.left = sceneClip.right - scrollX;
+		} else {
+			_tileClip.right = sceneClip.left - scrollX;
+		}
+		_vm->_gfx->drawRect(_tileClip, 0);
+		drawTiles(NULL);
+	}
+
+	if (scrollY != 0) {
+		_tileClip = sceneClip;
+		if (scrollY > 0) {
+			_tileClip.top = sceneClip.bottom - scrollY;
+		} else {
+			_tileClip.bottom = sceneClip.top - scrollY;
+		}
+		_vm->_gfx->drawRect(_tileClip, 0);
+		drawTiles(NULL);
+	}
 }
 
 void IsoMap::setMapPosition(int x, int y) {
@@ -532,6 +658,10 @@ void IsoMap::drawSpriteMetaTile(uint16 metaTileIndex, const Point &point, Locati
 		metaTile->highestPlatform = 0;
 	}
 
+	if (!isMetaTileVisible(metaTile, point)) {
+		return;
+	}
+
 	for (high = 0; high <= metaTile->highestPlatform; high++, platformPoint.y -= 8, location.z -= 8) {
 		assert(SAGA_MAX_PLATFORM_H > high);
 		platformIndex = metaTile->stack[high];
@@ -559,6 +689,10 @@ void IsoMap::drawMetaTile(uint16 metaTileIndex, const Point &point, int16 absU,
 		metaTile->highestPlatform = 0;
 	}
 
+	if (!isMetaTileVisible(metaTile, point)) {
+		return;
+	}
+
 	for (high = 0; high <= metaTile->highestPlatform; high++, platformPoint.y -= 8) {
 		assert(SAGA_MAX_PLATFORM_H > high);
 		platformIndex = metaTile->stack[high];
@@ -569,6 +703,18 @@ void IsoMap::drawMetaTile(uint16 metaTileIndex, const Point &point, int16 absU,
 	}
 }
 
+bool IsoMap::isMetaTileVisible(const MetaTileData *metaTile, const Point &point) const {
+	// The tiles of a platform are drawn up to (SAGA_PLATFORM_W - 1) * 16
+	// pixels left and right of its point, and up to the same distance plus
+	// the tile height above it. Each platform is 8 pixels above the previous.
+	const int reach = (SAGA_PLATFORM_W - 1) * 16;
+
+	return (point.x + reach + SAGA_ISOTILE_WIDTH > _tileClip.left) &&
+		(point.x - reach < _tileClip.right) &&
+		(point.y > _tileClip.top) &&
+		(point.y - metaTile->highestPlatform * 8 - reach - SAGA_MAX_TILE_H < _tileClip.bottom);
+}
+
 void IsoMap::drawSpritePlatform(uint16 platformIndex, const Point &point, const Location &location, int16 absU, int16 absV, int16 absH) {
 	TilePlatformData *tilePlatform;
 	int16 u, v;
@@ -810,7 +956,17 @@ void IsoMap::drawTile(uint16 tileIndex, const Point &point, const Location *loca
 
 	readPointer = tilePointer;
 	lowBound = MIN((int)(drawPoint.y + height), (int)_tileClip.bottom);
-	for (row = drawPoint.y; row < lowBound; row++) {
+	row = drawPoint.y;
+
+	// Start at the first visible row, if the rows of the tile are indexed
+	if (_tilesTable[tileIndex].rowIndex >= 0 && row < _tileClip.top) {
+		row = MIN<int>(_tileClip.top, lowBound);
+		if (row - drawPoint.y < height) {
+			readPointer = tilePointer + _tileRowOffsets[_tilesTable[tileIndex].rowIndex + row - drawPoint.y];
+		}
+	}
+
+	for (; row < lowBound; row++) {
 		widthCount = 0;
 		if (row >= _tileClip.top) {
 			drawPointer = _vm->_gfx->getBackBufferPixels() + drawPoint.x + (row * _vm->_gfx->getBackBufferPitch());
@@ -1603,6 +1759,8 @@ void IsoMap::setTileDoorState(int doorNumber, int doorState) {
 
 	multiTileEntryData = &_multiTable[doorNumber];
 	multiTileEntryData->currentState = doorState;
+
+	_staticLayerValid = false;
 }
 
 bool IsoMap::nextTileTarget(ActorData* actor) {
@@ -93,6 +93,7 @@ struct IsoTileData {
 	byte height;
 	int8 attributes;
 	byte *tilePointer;
+	int32 rowIndex;		// first entry of the tile in IsoMap::_tileRowOffsets, -1 if not indexed
 	uint16 terrainMask;
 	byte FGDBGDAttr;
 	int8 GetMaskRule() const {
@@ -183,6 +184,8 @@ private:
 	void drawPlatform(uint16 platformIndex, const Point &point, int16 absU, int16 absV, int16 absH);
 	void drawSpritePlatform(uint16 platformIndex, const Point &point, const Location &location, int16 absU, int16 absV, int16 absH);
 	void drawTile(uint16 tileIndex, const Point &point, const Location *location);
+	bool isMetaTileVisible(const MetaTileData *metaTile, const Point &point) const;
+	void drawScrolledTiles(const Rect &sceneClip, int16 scrollX, int16 scrollY);
 	int16 smoothSlide(int16 value, int16 min, int16 max) {
 		if (value < min) {
 			if (value < min - 100 || value > min - 4) {
@@ -211,6 +214,7 @@ private:
 
 	ByteArray _tileData;
 	Common::Array<IsoTileData> _tilesTable;
+	Common::Array<uint16> _tileRowOffsets;
 
 	Common::Array<TilePlatformData> _tilePlatformList;
 	Common::Array<MetaTileData> _metaTileList;
@@ -279,6 +283,14 @@ private:
 	Point _viewScroll;
 	Rect _tileClip;
 
+	// The tiles drawn by draw() for the scroll position and scene clip
+	// below. Only actors are drawn over them, so they are copied back
+	// on the next frame instead of being drawn again.
+	ByteArray _staticLayer;
+	Point _staticLayerScroll;
+	Rect _staticLayerClip;
+	bool _staticLayerValid;
+
 	SagaEngine *_vm;
 };
 
@@ -34,15 +34,16 @@
 
 // FIXME: This doesn't work yet correctly
 
+#include "common/array.h"
+#include "common/ptr.h"
 #include "common/util.h"
 
-#include "audio/decoders/raw.h"
-
 namespace Saga {
 
 #define MASKTABSIZE 33
 #define MAX_SUPPORTED_VERSION 3
 #define DEFAULT_BLOCK_SIZE 256
+#define LPC_QUANT 5
 
 enum kShortenTypes {
 	kTypeAU1 = 0,		// lossless ulaw
@@ -89,8 +90,10 @@ public:
 	uint32 getUint32(uint32 numBits);    // UINT_GET
 	int32 getURice(uint32 numBits);      // uvar_get
 	int32 getSRice(uint32 numBits);      // var_get
+	bool err() const { return _err; }
 private:
 	int _version;
+	bool _err;
 	uint32 _nbitget;
 	uint32 _buf;
 	uint32 _masktab[MASKTABSIZE];
@@ -104,6 +107,7 @@ ShortenGolombReader::ShortenGolombReader(Common::ReadStream *stream, int version
 	_masktab[0] = 0;
 	_nbitget = 0;
 	_buf = 0;
+	_err = false;
 
 	for (int i = 1; i < MASKTABSIZE; i++) {
 		val <<= 1;
@@ -122,6 +126,11 @@ int32 ShortenGolombReader::getURice(uint32 numBits) {
 
 	for (result = 0; !(_buf & (1L << --_nbitget)); result++) {
 		if (!_nbitget) {
+			// A truncated stream would otherwise keep us here forever
+			if (_stream->eos() || _stream->err()) {
+				_err = true;
+				return 0;
+			}
 			_buf = _stream->readUint32BE();
 			_nbitget = 32;
 		}
@@ -154,76 +163,139 @@ uint32 ShortenGolombReader::getUint32(uint32 numBits) {
 
 // ---------------------------------------------------------------------------
 
-byte *loadShortenFromStream(Common::ReadStream &stream, int &size, int &rate, byte &flags) {
-	int32 *buffer[2], *offset[2];	// up to 2 channels
-	int32 *oldValues[2];
-	byte *unpackedBuffer = 0;
-	byte *pBuf = unpackedBuffer;
-	int prevSize = 0;
-	int32 *lpc = 0;
-
-	ShortenGolombReader *gReader;
-	uint32 i, j, version, mean, type, channels, blockSize;
-	uint32 maxLPC = 0, lpcqOffset = 0;
-	int32 bitShift = 0, wrap = 0;
-	flags = 0;
-	size = 0;
+/**
+ * Audio stream decoding a Shorten file one block at a time, as the
+ * samples are requested.
+ */
+class ShortenStream : public Audio::RewindableAudioStream {
+public:
+	ShortenStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+	~ShortenStream();
+
+	bool isValid() const { return _reader != 0; }
+
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool isStereo() const { return _channels == 2; }
+	// Rate is always 44100Hz
+	int getRate() const { return 44100; }
+	bool endOfData() const { return _endOfStream && _samplePos >= _samples.size(); }
+	bool rewind();
+
+private:
+	Common::DisposablePtr<Common::SeekableReadStream> _stream;
+	int32 _startPos;
+	ShortenGolombReader *_reader;
+
+	uint32 _version, _type, _channels, _blockSize;
+	uint32 _mean, _maxLPC, _wrap;
+	int32 _bitShift, _lpcqOffset;
+	bool _is16Bit, _isUnsigned;
+	int32 _limit;
+
+	// Every channel buffer holds _wrap samples of the previous blocks,
+	// followed by the current block
+	Common::Array<int32> _buffer[2];
+	Common::Array<int32> _offset[2];
+	Common::Array<int32> _lpc;
+	uint32 _curChannel;
+
+	// The samples of the last decoded block, interleaved
+	Common::Array<int16> _samples;
+	uint32 _samplePos;
+	bool _endOfStream;
+
+	bool readHeader();
+	void setBlockSize(uint32 blockSize);
+	bool decodeBlock();
+	bool decodeChannel(uint32 cmd);
+	int16 convertSample(int32 sample) const;
+};
+
+ShortenStream::ShortenStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse)
+		: _stream(stream, disposeAfterUse), _startPos(stream->pos()), _reader(0) {
+	if (!readHeader()) {
+		delete _reader;
+		_reader = 0;
+	}
+}
+
+ShortenStream::~ShortenStream() {
+	delete _reader;
+}
+
+bool ShortenStream::rewind() {
+	delete _reader;
+	_reader = 0;
+
+	_stream->seek(_startPos);
+	if (!readHeader()) {
+		delete _reader;
+		_reader = 0;
+		_endOfStream = true;
+		return false;
+	}
+
+	return true;
+}
+
+bool ShortenStream::readHeader() {
+	_samples.clear();
+	_samplePos = 0;
+	_endOfStream = false;
+	_curChannel = 0;
+	_bitShift = 0;
+	_maxLPC = 0;
+	_is16Bit = _isUnsigned = false;
 
 	// Read header
 	byte magic[4];
-	stream.read(magic, 4);
+	_stream->read(magic, 4);
 	if (memcmp(magic, "ajkg", 4) != 0) {
-		warning("loadShortenFromStream: No 'ajkg' header");
-		return NULL;
+		warning("ShortenStream: No 'ajkg' header");
+		return false;
 	}
 
-	version = stream.readByte();
+	_version = _stream->readByte();
 
-	if (version > MAX_SUPPORTED_VERSION) {
-		warning("loadShortenFromStream: Can't decode version %d, maximum supported version is %d", version, MAX_SUPPORTED_VERSION);
-		return NULL;
+	if (_version > MAX_SUPPORTED_VERSION) {
+		warning("ShortenStream: Can't decode version %d, maximum supported version is %d", _version, MAX_SUPPORTED_VERSION);
+		return false;
 	}
 
-	mean = (version < 2) ? 0 : 4;
+	_mean = (_version < 2) ? 0 : 4;
 
-	gReader = new ShortenGolombReader(&stream, version);
+	_reader = new ShortenGolombReader(_stream.get(), _version);
 
 	// Get file type
-	type = gReader->getUint32(4);
+	_type = _reader->getUint32(4);
+
+	int32 offsetMean = 0;
 
-	switch (type) {
+	switch (_type) {
 		case kTypeS8:
-			mean = 0;
 			break;
 		case kTypeU8:
-			flags |= Audio::FLAG_UNSIGNED;
-			mean = 0x80;
+			_isUnsigned = true;
+			offsetMean = 0x80;
 			break;
 		case kTypeS16LH:
-			flags |= Audio::FLAG_LITTLE_ENDIAN;
-			// fallthrough
 		case kTypeS16HL:
-			flags |= Audio::FLAG_16BITS;
-			mean = 0;
+			_is16Bit = true;
 			break;
 		case kTypeU16LH:
-			flags |= Audio::FLAG_LITTLE_ENDIAN;
-			// fallthrough
 		case kTypeU16HL:
-			flags |= Audio::FLAG_16BITS;
-			flags |= Audio::FLAG_UNSIGNED;
-			mean = 0x8000;
+			_is16Bit = true;
+			_isUnsigned = true;
+			offsetMean = 0x8000;
 			break;
 		case kTypeWAV:
 			// TODO: Perhaps implement this if we find WAV Shorten encoded files
-			warning("loadShortenFromStream: Type WAV is not supported");
-			delete gReader;
-			return NULL;
+			warning("ShortenStream: Type WAV is not supported");
+			return false;
 		case kTypeAIFF:
 			// TODO: Perhaps implement this if we find AIFF Shorten encoded files
-			warning("loadShortenFromStream: Type AIFF is not supported");
-			delete gReader;
-			return NULL;
+			warning("ShortenStream: Type AIFF is not supported");
+			return false;
 		case kTypeAU1:
 		case kTypeAU2:
 		case kTypeAU3:
@@ -233,332 +305,284 @@ byte *loadShortenFromStream(Common::ReadStream &stream, int &size, int &rate, by
 		case kTypeGenericULaw:
 		case kTypeGenericALaw:
 		default:
-			warning("loadShortenFromStream: Type %d is not supported", type);
-			delete gReader;
-			return NULL;
+			warning("ShortenStream: Type %d is not supported", _type);
+			return false;
 	}
 
+	_limit = _is16Bit ? 32767 : 127;
+	if (_isUnsigned)
+		_limit = _limit * 2 + 1;
+
 	// Get channels
-	channels = gReader->getUint32(0);
-	if (channels != 1 && channels != 2) {
-		warning("loadShortenFromStream: Only 1 or 2 channels are supported, stream contains %d channels", channels);
-		delete gReader;
-		return NULL;
+	_channels = _reader->getUint32(0);
+	if (_channels != 1 && _channels != 2) {
+		warning("ShortenStream: Only 1 or 2 channels are supported, stream contains %d channels", _channels);
+		return false;
 	}
 
 	// Get block size
-	if (version > 0) {
-		blockSize = gReader->getUint32((int) (log((double) DEFAULT_BLOCK_SIZE) / M_LN2));
-		maxLPC = gReader->getUint32(2);
-		mean = gReader->getUint32(0);
-		uint32 skipBytes = gReader->getUint32(1);
-		if (skipBytes > 0) {
-			prevSize = size;
-			size += skipBytes;
-			unpackedBuffer = (byte *) realloc(unpackedBuffer, size);
-			pBuf = unpackedBuffer + prevSize;
-			for (i = 0; i < skipBytes; i++) {
-				*pBuf++ = gReader->getUint32(7) & 0xFF;
-			}
-		}
-	} else {
-		blockSize = DEFAULT_BLOCK_SIZE;
+	uint32 blockSize = DEFAULT_BLOCK_SIZE;
+	if (_version > 0) {
+		blockSize = _reader->getUint32((int) (log((double) DEFAULT_BLOCK_SIZE) / M_LN2));
+		_maxLPC = _reader->getUint32(2);
+		_mean = _reader->getUint32(0);
+
+		// The skipped bytes hold the header of the original file, which
+		// is of no use for playback
+		uint32 skipBytes = _reader->getUint32(1);
+		while (skipBytes-- > 0)
+			_reader->getUint32(7);
+	}
+
+	if (_reader->err() || blockSize == 0) {
+		warning("ShortenStream: Invalid header");
+		return false;
 	}
 
-	wrap = MAX<uint32>(3, maxLPC);
+	_wrap = MAX<uint32>(3, _maxLPC);
+	_lpcqOffset = (_version > 1) ? (1 << LPC_QUANT) : 0;
+	_lpc.resize(_maxLPC);
 
-	// Initialize buffers
-	for (i = 0; i < channels; i++) {
-		buffer[i] = (int32 *)malloc((blockSize + wrap) * 4);
-		offset[i] = (int32 *)malloc((MAX<uint32>(1, mean)) * 4);
-		oldValues[i] = (int32 *)malloc(64 * 4);
-		memset(buffer[i], 0, (blockSize + wrap) * 4);
-		memset(offset[i], 0, (MAX<uint32>(1, mean)) * 4);
-		memset(oldValues[i], 0, 64 * 4);
+	for (uint32 i = 0; i < _channels; i++) {
+		_buffer[i].clear();
+		_buffer[i].resize(_wrap);
+		for (uint32 j = 0; j < _wrap; j++)
+			_buffer[i][j] = 0;
+
+		_offset[i].resize(MAX<uint32>(1, _mean));
+		for (uint32 j = 0; j < _offset[i].size(); j++)
+			_offset[i][j] = offsetMean;
 	}
 
-	if (maxLPC > 0)
-		lpc = (int32 *) malloc(maxLPC * 4);
+	_blockSize = 0;
+	setBlockSize(blockSize);
 
-	if (version > 1)
-		lpcqOffset = 1 << 5;
+	return true;
+}
 
-	// Init offset
-	int32 offsetMean = 0;
-	uint32 blocks = MAX<int>(1, mean);
+void ShortenStream::setBlockSize(uint32 blockSize) {
+	// The history in front of the block stays where it is
+	for (uint32 i = 0; i < _channels; i++)
+		_buffer[i].resize(_wrap + blockSize);
 
-	if (type == kTypeU8)
-		offsetMean = 0x80;
-	else if (type == kTypeU16HL || type == kTypeU16LH)
-		offsetMean = 0x8000;
+	_blockSize = blockSize;
+}
 
-	for (uint32 channel = 0; channel < channels; channel++)
-		for (uint32 block = 0; block < blocks; block++)
-			offset[channel][block] = offsetMean;
+int ShortenStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
 
+	while (samples < numSamples) {
+		if (_samplePos >= _samples.size() && (_endOfStream || !decodeBlock()))
+			break;
 
-	uint32 curChannel = 0, cmd = 0;
+		int count = MIN<int>(numSamples - samples, _samples.size() - _samplePos);
+		memcpy(buffer + samples, &_samples[_samplePos], count * sizeof(int16));
+		_samplePos += count;
+		samples += count;
+	}
 
-	// Parse Shorten commands
-	while (true) {
-		cmd = gReader->getURice(2);
+	return samples;
+}
+
+bool ShortenStream::decodeBlock() {
+	// Parse Shorten commands until every channel has got a new block
+	while (!_endOfStream) {
+		uint32 cmd = _reader->getURice(2);
 
-		if (cmd == kCmdQuit)
+		if (_reader->err()) {
+			warning("ShortenStream: Unexpected end of stream");
+			_endOfStream = true;
 			break;
+		}
 
 		switch (cmd) {
+			case kCmdQuit:
+				_endOfStream = true;
+				break;
 			case kCmdZero:
 			case kCmdDiff0:
 			case kCmdDiff1:
 			case kCmdDiff2:
 			case kCmdDiff3:
 			case kCmdQLPC:
-				{
-				int32 channelOffset = 0, energy = 0;
-				uint32 lpcNum = 0;
-
-				if (cmd != kCmdZero) {
-					energy = gReader->getURice(3);
-					// hack for version 0
-					if (version == 0)
-						energy--;
+				if (!decodeChannel(cmd)) {
+					_endOfStream = true;
+					break;
 				}
 
-				// Find mean offset (code duplicated below)
-				if (mean == 0) {
-					channelOffset = offset[curChannel][0];
-				} else {
-					int32 sum = (version < 2) ? 0 : mean / 2;
-					for (i = 0; i < mean; i++)
-						sum += offset[curChannel][i];
+				if (_curChannel == _channels - 1) {
+					_samples.resize(_blockSize * _channels);
+					_samplePos = 0;
 
-					channelOffset = sum / mean;
+					int16 *dst = _samples.begin();
+					for (uint32 i = 0; i < _blockSize; i++)
+						for (uint32 j = 0; j < _channels; j++)
+							*dst++ = convertSample(_buffer[j][_wrap + i]);
 
-					if (version >= 2 && bitShift > 0)
-						channelOffset = (channelOffset >> (bitShift - 1)) >> 1;
+					_curChannel = 0;
+					return true;
 				}
 
-				switch (cmd) {
-					case kCmdZero:
-						for (i = 0; i < blockSize; i++)
-							buffer[curChannel][i] = 0;
-						break;
-					case kCmdDiff0:
-						for (i = 0; i < blockSize; i++)
-							buffer[curChannel][i] = gReader->getSRice(energy) + channelOffset;
-						break;
-					case kCmdDiff1:
-						for (i = 0; i < blockSize; i++) {
-							if (i == 0)
-								buffer[curChannel][i] = gReader->getSRice(energy) + oldValues[curChannel][0];
-							else
-								buffer[curChannel][i] = gReader->getSRice(energy) + buffer[curChannel][i - 1];
-						}
-						break;
-					case kCmdDiff2:
-						for (i = 0; i < blockSize; i++) {
-							if (i == 0)
-								buffer[curChannel][i] = gReader->getSRice(energy) + 2 * oldValues[curChannel][0] - oldValues[curChannel][1];
-							else if (i == 1)
-								buffer[curChannel][i] = gReader->getSRice(energy) + 2 * buffer[curChannel][0] - oldValues[curChannel][0];
-							else
-								buffer[curChannel][i] = gReader->getSRice(energy) + 2 * buffer[curChannel][i - 1] - buffer[curChannel][i - 2];
-						}
-						break;
-					case kCmdDiff3:
-						for (i = 0; i < blockSize; i++) {
-							if (i == 0)
-								buffer[curChannel][i] = gReader->getSRice(energy) + 3 * (oldValues[curChannel][0] - oldValues[curChannel][1]) + oldValues[curChannel][2];
-							else if (i == 1)
-								buffer[curChannel][i] = gReader->getSRice(energy) + 3 * (buffer[curChannel][0] - oldValues[curChannel][0]) + oldValues[curChannel][1];
-							else if (i == 2)
-								buffer[curChannel][i] = gReader->getSRice(energy) + 3 * (buffer[curChannel][1] - buffer[curChannel][0]) + oldValues[curChannel][0];
-							else
-								buffer[curChannel][i] = gReader->getSRice(energy) + 3 * (buffer[curChannel][i - 1] - buffer[curChannel][i - 2]) + buffer[curChannel][i - 3];
-						}
-						break;
-					case kCmdQLPC:
-						lpcNum = gReader->getURice(2);
-
-						// Safeguard: if maxLPC < lpcNum, realloc the lpc buffer
-						if (maxLPC < lpcNum) {
-							warning("Safeguard: maxLPC < lpcNum (should never happen)");
-							maxLPC = lpcNum;
-							int32 *tmp = (int32 *) realloc(lpc, maxLPC * 4);
-							if ((tmp != NULL) || (maxLPC == 0)) {
-								lpc = tmp;
-							} else {
-								error("loadShortenFromStream(): Error while reallocating memory");
-							}
-						}
-
-						for (i = 0; i < lpcNum; i++)
-							lpc[i] = gReader->getSRice(5);
-
-						for (i = 0; i < lpcNum; i++)
-							buffer[curChannel][i - lpcNum] -= channelOffset;
-
-						for (i = 0; i < blockSize; i++) {
-							int32 sum = lpcqOffset;
-							for (j = 0; j < lpcNum; j++) {
-								// FIXME: The original code did an invalid memory access here
-								// (if i and j are 0, the array index requested is -1)
-								// I've removed those invalid writes, since they happen all the time (even when curChannel is 0)
-								if (i <= j)	// ignore invalid table/memory access
-									continue;
-								sum += lpc[j] * buffer[curChannel][i - j - 1];
-							}
-							buffer[curChannel][i] = gReader->getSRice(energy) + (sum >> 5);
-						}
-
-						if (channelOffset > 0)
-							for (i = 0; i < blockSize; i++)
-								buffer[curChannel][i] += channelOffset;
-
-						break;
+				_curChannel++;
+				break;
+			case kCmdBlockSize:
+				setBlockSize(_reader->getUint32((uint32)(log((double) _blockSize) / M_LN2)));
+				break;
+			case kCmdBitShift:
+				_bitShift = _reader->getURice(2);
+				break;
+			case kCmdVerbatim:
+				{
+				// Verbatim data is not audio, skip it
+				uint32 vLen = (uint32)_reader->getURice(5);
+				while (vLen--)
+					_reader->getURice(8);
 				}
+				break;
+			default:
+				warning("ShortenStream: Unknown command: %d", cmd);
+				_endOfStream = true;
+				break;
+		}
+	}
 
-				// Store mean value, if appropriate (duplicated code from above)
-				if (mean > 0) {
-					int32 sum = (version < 2) ? 0 : blockSize / 2;
-					for (i = 0; i < blockSize; i++)
-						sum += buffer[curChannel][i];
+	return false;
+}
 
-					for (i = 1; i < mean; i++)
-						offset[curChannel][i - 1] = offset[curChannel][i];
+bool ShortenStream::decodeChannel(uint32 cmd) {
+	int32 *buffer = &_buffer[_curChannel][_wrap];
+	int32 *offset = _offset[_curChannel].begin();
+	const int32 blockSize = _blockSize;
+	const int32 mean = _mean;
+	const int32 wrap = _wrap;
+	int32 channelOffset = 0, energy = 0;
+	int32 i, j;
+
+	if (cmd != kCmdZero) {
+		energy = _reader->getURice(3);
+		// hack for version 0
+		if (_version == 0)
+			energy--;
+	}
 
-					offset[curChannel][mean - 1] = sum / blockSize;
+	// Find mean offset
+	if (mean == 0) {
+		channelOffset = offset[0];
+	} else {
+		int32 sum = (_version < 2) ? 0 : mean / 2;
+		for (i = 0; i < mean; i++)
+			sum += offset[i];
 
-					if (version >= 2 && bitShift > 0)
-						offset[curChannel][mean - 1] = offset[curChannel][mean - 1] << bitShift;
-				}
+		channelOffset = sum / mean;
 
+		if (_version >= 2 && _bitShift > 0)
+			channelOffset = (channelOffset >> (_bitShift - 1)) >> 1;
+	}
 
-				// Do the wrap
-				for (i = 0; i < 64; ++i)
-					oldValues[curChannel][i] = 0;
+	// The samples before buffer[0] are the last ones of the previous block
+	switch (cmd) {
+		case kCmdZero:
+			for (i = 0; i < blockSize; i++)
+				buffer[i] = 0;
+			break;
+		case kCmdDiff0:
+			for (i = 0; i < blockSize; i++)
+				buffer[i] = _reader->getSRice(energy) + channelOffset;
+			break;
+		case kCmdDiff1:
+			for (i = 0; i < blockSize; i++)
+				buffer[i] = _reader->getSRice(energy) + buffer[i - 1];
+			break;
+		case kCmdDiff2:
+			for (i = 0; i < blockSize; i++)
+				buffer[i] = _reader->getSRice(energy) + 2 * buffer[i - 1] - buffer[i - 2];
+			break;
+		case kCmdDiff3:
+			for (i = 0; i < blockSize; i++)
+				buffer[i] = _reader->getSRice(energy) + 3 * (buffer[i - 1] - buffer[i - 2]) + buffer[i - 3];
+			break;
+		case kCmdQLPC:
+			{
+			int32 lpcNum = _reader->getURice(2);
 
-				uint arrayTerminator = MIN<int>(64, blockSize);
-				for (i = 0; i < arrayTerminator; ++i)
-					oldValues[curChannel][i] = buffer[curChannel][blockSize - (i + 1)];
+			if (lpcNum > (int32)_maxLPC) {
+				warning("ShortenStream: LPC order %d exceeds the maximum of %d", lpcNum, _maxLPC);
+				return false;
+			}
 
-				// Fix bitshift
-				if (bitShift > 0) {
-					for (i = 0; i < blockSize; i++)
-						buffer[curChannel][i] <<= bitShift;
-				}
+			for (i = 0; i < lpcNum; i++)
+				_lpc[i] = _reader->getSRice(5);
 
-				if (curChannel == channels - 1) {
-					int dataSize = (flags & Audio::FLAG_16BITS) ? 2 : 1;
-					int limit = (flags & Audio::FLAG_16BITS) ? 32767 : 127;
-					limit = (flags & Audio::FLAG_UNSIGNED) ? limit * 2 + 1 : limit;
-
-					prevSize = size;
-					size += (blockSize * dataSize);
-					byte *tmp = (byte *) realloc(unpackedBuffer, size);
-					if ((tmp != NULL) || (size == 0)) {
-						unpackedBuffer = tmp;
-					} else {
-						error("loadShortenFromStream(): Error while reallocating memory");
-					}
-					pBuf = unpackedBuffer + prevSize;
-
-					if (flags & Audio::FLAG_16BITS) {
-						for (i = 0; i < blockSize; i++) {
-							for (j = 0; j < channels; j++) {
-								int16 val = (int16)(MIN<int32>(buffer[j][i], limit) & 0xFFFF);
-								// values are written in LE
-								*pBuf++ = (byte) (val & 0xFF);
-								*pBuf++ = (byte) ((val >> 8) & 0xFF);
-							}
-						}
-					} else {
-						for (i = 0; i < blockSize; i++)
-							for (j = 0; j < channels; j++)
-								*pBuf++ = (byte)(MIN<int32>(buffer[j][i], limit) & 0xFF);
-					}
-				}
-				curChannel = (curChannel + 1) % channels;
+			for (i = 0; i < lpcNum; i++)
+				buffer[i - lpcNum] -= channelOffset;
 
-				}
-				break;
-			case kCmdBlockSize:
-				blockSize = gReader->getUint32((uint32)log((double) blockSize / M_LN2));
-				break;
-			case kCmdBitShift:
-				bitShift = gReader->getURice(2);
-				break;
-			case kCmdVerbatim:
-				{
+			for (i = 0; i < blockSize; i++) {
+				int32 sum = _lpcqOffset;
+				for (j = 0; j < lpcNum; j++)
+					sum += _lpc[j] * buffer[i - j - 1];
+				buffer[i] = _reader->getSRice(energy) + (sum >> LPC_QUANT);
+			}
 
-				uint32 vLen = (uint32)gReader->getURice(5);
-				prevSize = size;
-				size += vLen;
-				byte *tmp = (byte *) realloc(unpackedBuffer, size);
-				if ((tmp != NULL) || (size == 0)) {
-					unpackedBuffer = tmp;
-				} else {
-					error("loadShortenFromStream(): Error while reallocating memory");
-				}
-				pBuf = unpackedBuffer + prevSize;
+			if (channelOffset != 0)
+				for (i = 0; i < blockSize; i++)
+					buffer[i] += channelOffset;
+			}
+			break;
+	}
 
-				while (vLen--) {
-					*pBuf++ = (byte)(gReader->getURice(8) & 0xFF);
-				}
+	// Store mean value, if appropriate
+	if (mean > 0) {
+		int32 sum = (_version < 2) ? 0 : blockSize / 2;
+		for (i = 0; i < blockSize; i++)
+			sum += buffer[i];
 
-				}
-				break;
-			default:
-				warning("loadShortenFromStream: Unknown command: %d", cmd);
+		for (i = 1; i < mean; i++)
+			offset[i - 1] = offset[i];
 
-				// Cleanup
-				for (i = 0; i < channels; i++) {
-					free(buffer[i]);
-					free(offset[i]);
-					free(oldValues[i]);
-				}
+		offset[mean - 1] = sum / blockSize;
 
-				if (maxLPC > 0)
-					free(lpc);
+		if (_version >= 2 && _bitShift > 0)
+			offset[mean - 1] = offset[mean - 1] << _bitShift;
+	}
 
-				if (size > 0)
-					free(unpackedBuffer);
+	// Do the wrap
+	for (i = -wrap; i < 0; i++)
+		buffer[i] = buffer[i + blockSize];
 
-				delete gReader;
-				return NULL;
-				break;
-		}
+	// Fix bitshift
+	if (_bitShift > 0) {
+		for (i = 0; i < blockSize; i++)
+			buffer[i] <<= _bitShift;
 	}
 
-	// Rate is always 44100Hz
-	rate = 44100;
+	return !_reader->err();
+}
 
-	// Cleanup
-	for (i = 0; i < channels; i++) {
-		free(buffer[i]);
-		free(offset[i]);
-		free(oldValues[i]);
-	}
+int16 ShortenStream::convertSample(int32 sample) const {
+	// Values above the limit are clipped, others wrap around
+	sample = MIN<int32>(sample, _limit);
 
-	if (maxLPC > 0)
-		free(lpc);
+	if (_is16Bit) {
+		int16 val = (int16)(sample & 0xFFFF);
+		return _isUnsigned ? (int16)(val ^ 0x8000) : val;
+	}
 
-	delete gReader;
-	return unpackedBuffer;
+	byte val = (byte)(sample & 0xFF);
+	return _isUnsigned ? (int16)((val ^ 0x80) << 8) : (int16)(val << 8);
 }
 
-Audio::AudioStream *makeShortenStream(Common::SeekableReadStream &stream) {
-	int size, rate;
-	byte *data, flags;
-	data = loadShortenFromStream(stream, size, rate, flags);
+// ---------------------------------------------------------------------------
+
+Audio::RewindableAudioStream *makeShortenStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	ShortenStream *s = new ShortenStream(stream, disposeAfterUse);
 
-	if (!data)
-		return 0;
+	if (s->isValid())
+		return s;
 
-	// Since we allocated our own buffer for the data, we must specify DisposeAfterUse::YES.
-	return Audio::makeRawStream(data, size, rate, flags);
+	delete s;
+	return 0;
 }
 
-} // End of namespace Audio
+} // End of namespace Saga
 
 #endif // defined(SOUND_SHORTEN_H)
@@ -31,26 +31,24 @@
 
 #include "common/scummsys.h"
 #include "common/stream.h"
+#include "common/types.h"
 
 #include "audio/audiostream.h"
 
 namespace Saga {
 
 /**
- * Try to load a Shorten file from the given stream. Returns true if
- * successful. In that case, the stream's seek position will be set to the
- * start of the audio data, and size, rate and flags contain information
- * necessary for playback.
- */
-byte *loadShortenFromStream(Common::ReadStream &stream, int &size, int &rate, byte &flags);
-
-/**
- * Try to load a Shorten file from the given stream and create an AudioStream
- * from that data.
+ * Create a new RewindableAudioStream from the Shorten data in the given
+ * stream. The data is decoded one block at a time, while the samples are
+ * being read, so the decoded file is never held in memory as a whole.
  *
- * This function uses loadShortenFromStream() internally.
+ * @param stream			the SeekableReadStream from which to read the Shorten data
+ * @param disposeAfterUse	whether to delete the stream after use
+ * @return	a new RewindableAudioStream, or NULL, if an error occurred
  */
-Audio::AudioStream *makeShortenStream(Common::ReadStream &stream);
+Audio::RewindableAudioStream *makeShortenStream(
+	Common::SeekableReadStream *stream,
+	DisposeAfterUse::Flag disposeAfterUse);
 
 } // End of namespace Audio
 
@@ -339,14 +339,7 @@ bool SndRes::load(ResourceContext *context, uint32 resourceId, SoundBuffer &buff
 		result = true;
 		} break;
 	case kSoundWAV:
-	case kSoundShorten:
-		if (resourceType == kSoundWAV) {
-			result = Audio::loadWAVFromStream(readS, size, rate, rawFlags);
-#ifdef ENABLE_SAGA2
-		} else if (resourceType == kSoundShorten) {
-			result = loadShortenFromStream(readS, size, rate, rawFlags);
-#endif
-		}
+		result = Audio::loadWAVFromStream(readS, size, rate, rawFlags);
 
 		if (result) {
 			Audio::SeekableAudioStream *audStream = Audio::makeRawStream(READ_STREAM(size), rate, rawFlags);
@@ -354,6 +347,29 @@ bool SndRes::load(ResourceContext *context, uint32 resourceId, SoundBuffer &buff
 			buffer.streamLength = audStream->getLength();
 		}
 		break;
+	case kSoundShorten: {
+#ifdef ENABLE_SAGA2
+		Audio::RewindableAudioStream *audStream = makeShortenStream(READ_STREAM(soundResourceLength), DisposeAfterUse::YES);
+		if (audStream) {
+			buffer.stream = audStream;
+			result = true;
+
+			// Shorten files do not store their length, so the whole file
+			// has to be decoded to find it out. Only do so when asked for.
+			if (onlyHeader) {
+				int16 samples[2048];
+				uint32 total = 0;
+				int count;
+				while ((count = audStream->readBuffer(samples, ARRAYSIZE(samples))) > 0)
+					total += count;
+
+				buffer.streamLength = Audio::Timestamp(0, total / (audStream->isStereo() ? 2 : 1), audStream->getRate());
+			}
+		}
+#else
+		warning("SndRes::load Shorten sounds are not supported");
+#endif
+		} break;
 	case kSoundMP3:
 	case kSoundOGG:
 	case kSoundFLAC: {
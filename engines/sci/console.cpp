@@ -233,6 +233,9 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+
+	_lastStepCounter = 0;
+	_lastStepTime = g_system->getMillis();
 }
 
 Console::~Console() {
@@ -430,7 +433,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" bp_function / bpe - Sets a breakpoint on the execution of the specified exported function\n");
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
-	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" script_steps - Shows the number of executed SCI operations and the selector cache usage\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -2726,7 +2729,24 @@ bool Console::cmdViewAccumulatorObject(int argc, const char **argv) {
 }
 
 bool Console::cmdScriptSteps(int argc, const char **argv) {
-	debugPrintf("Number of executed SCI operations: %d\n", _engine->_gamestate->scriptStepCounter);
+	EngineState *s = _engine->_gamestate;
+	debugPrintf("Number of executed SCI operations: %d\n", s->scriptStepCounter);
+
+	// The game is paused while the console is open, so this only covers
+	// the time the game ran between two calls
+	const uint32 curTime = g_system->getMillis();
+	const uint32 elapsed = curTime - _lastStepTime;
+	if (elapsed > 0 && s->scriptStepCounter >= _lastStepCounter) {
+		debugPrintf("Operations per second since the last call: %d\n",
+			(int)((int64)(s->scriptStepCounter - _lastStepCounter) * 1000 / elapsed));
+	}
+	_lastStepCounter = s->scriptStepCounter;
+	_lastStepTime = curTime;
+
+	const uint32 hits = s->_segMan->getSelectorCacheHits();
+	const uint32 lookups = hits + s->_segMan->getSelectorCacheMisses();
+	debugPrintf("Selector lookup cache: %d hits, %d misses (%d%% hit rate)\n",
+		hits, lookups - hits, lookups ? (int)((uint64)hits * 100 / lookups) : 0);
 	return true;
 }
 
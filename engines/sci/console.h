@@ -177,6 +177,11 @@ private:
 	DebugState &_debugState;
 	Common::String _videoFile;
 	int _videoFrameDelay;
+
+	// Step counter and time of the previous script_steps call, used to
+	// report the number of executed operations per second
+	int _lastStepCounter;
+	uint32 _lastStepTime;
 };
 
 } // End of namespace Sci
@@ -40,6 +40,9 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
+	_selectorCacheHits = 0;
+	_selectorCacheMisses = 0;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_stringSegId = 0;
@@ -155,6 +158,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		clearSelectorCache();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -172,6 +176,28 @@ void SegManager::deallocate(SegmentId seg) {
 	_heap[seg] = NULL;
 }
 
+const SegManager::SelectorCacheEntry *SegManager::getCachedSelector(reg_t objPos, Selector selector) {
+	SelectorCacheKey key;
+	key.objPos = objPos;
+	key.selector = selector;
+
+	SelectorCache::const_iterator i = _selectorCache.find(key);
+	if (i == _selectorCache.end()) {
+		_selectorCacheMisses++;
+		return NULL;
+	}
+
+	_selectorCacheHits++;
+	return &i->_value;
+}
+
+void SegManager::cacheSelector(reg_t objPos, Selector selector, const SelectorCacheEntry &entry) {
+	SelectorCacheKey key;
+	key.objPos = objPos;
+	key.selector = selector;
+	_selectorCache[key] = entry;
+}
+
 bool SegManager::isHeapObject(reg_t pos) const {
 	const Object *obj = getObject(pos);
 	if (obj == NULL || (obj && obj->isFreed()))
@@ -977,6 +1003,7 @@ int SegManager::instantiateScript(int scriptNum) {
 			return segmentId;
 		} else {
 			scr->freeScript();
+			clearSelectorCache();
 		}
 	} else {
 		scr = allocateScript(scriptNum, &segmentId);
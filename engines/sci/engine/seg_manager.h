@@ -441,7 +441,48 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * A cached result of lookupSelector(). The method and variable tables
+	 * of an object and its superclasses only depend on the object it was
+	 * created from, so the results are keyed by the object position
+	 * (which is the same for an object and its clones) and the selector.
+	 */
+	struct SelectorCacheEntry {
+		SelectorType type;
+		int varIndex;
+		reg_t funcp;
+	};
+
+	const SelectorCacheEntry *getCachedSelector(reg_t objPos, Selector selector);
+	void cacheSelector(reg_t objPos, Selector selector, const SelectorCacheEntry &entry);
+
+	/** Forget all cached selector lookups, done whenever a script is unloaded. */
+	void clearSelectorCache() { _selectorCache.clear(); }
+
+	uint32 getSelectorCacheHits() const { return _selectorCacheHits; }
+	uint32 getSelectorCacheMisses() const { return _selectorCacheMisses; }
+
 private:
+	struct SelectorCacheKey {
+		reg_t objPos;
+		Selector selector;
+
+		bool operator==(const SelectorCacheKey &x) const {
+			return objPos == x.objPos && selector == x.selector;
+		}
+	};
+
+	struct SelectorCacheKey_Hash {
+		uint operator()(const SelectorCacheKey &x) const {
+			return (x.objPos.getSegment() << 16) ^ x.objPos.getOffset() ^ (x.selector * 2654435761U);
+		}
+	};
+
+	typedef Common::HashMap<SelectorCacheKey, SelectorCacheEntry, SelectorCacheKey_Hash> SelectorCache;
+	SelectorCache _selectorCache;
+	uint32 _selectorCacheHits;
+	uint32 _selectorCacheMisses;
+
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
@@ -265,32 +265,48 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				PRINT_REG(obj_location));
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
+	const reg_t objPos = obj->getPos();
+	const SegManager::SelectorCacheEntry *cached = segMan->getCachedSelector(objPos, selectorId);
+	SegManager::SelectorCacheEntry entry;
 
-	if (index >= 0) {
-		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
-		return kSelectorVariable;
+	if (cached) {
+		entry = *cached;
 	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
+		entry.type = kSelectorNone;
+		entry.varIndex = obj->locateVarSelector(segMan, selectorId);
+		entry.funcp = NULL_REG;
+
+		if (entry.varIndex >= 0) {
+			// Found it as a variable
+			entry.type = kSelectorVariable;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			while (obj) {
+				index = obj->funcSelectorPosition(selectorId);
+				if (index >= 0) {
+					entry.type = kSelectorMethod;
+					entry.funcp = obj->getFunction(index);
+					break;
+				} else {
+					obj = segMan->getObject(obj->getSuperClassSelector());
+				}
 			}
 		}
 
-		return kSelectorNone;
+		segMan->cacheSelector(objPos, selectorId, entry);
+	}
+
+	if (entry.type == kSelectorVariable) {
+		if (varp) {
+			varp->obj = obj_location;
+			varp->varindex = entry.varIndex;
+		}
+	} else if (entry.type == kSelectorMethod) {
+		if (fptr)
+			*fptr = entry.funcp;
 	}
 
+	return entry.type;
 
 //	return _lookupSelector_function(segMan, obj, selectorId, fptr);
 }
@@ -567,6 +567,8 @@ void run_vm(EngineState *s) {
 	byte prevOpcode = 0xFF;
 #endif
 
+	Console *con = g_sci->getSciDebugger();
+
 	while (1) {
 		int var_type; // See description below
 		int var_number;
@@ -599,17 +601,15 @@ void run_vm(EngineState *s) {
 			s->variables[VAR_PARAM] = s->xs->variables_argp;
 		}
 
-		if (s->abortScriptProcessing != kAbortNone)
-			return; // Stop processing
-
-		// Debug if this has been requested:
+		// Debug if this has been requested. Both checks are plain flags, so
+		// nothing else is done per instruction while no debugging happens.
 		// TODO: re-implement sci_debug_flags
 		if (g_sci->_debugState.debugging /* sci_debug_flags*/) {
 			g_sci->scriptDebug();
 			g_sci->_debugState.breakpointWasHit = false;
 		}
-		Console *con = g_sci->getSciDebugger();
-		con->onFrame();
+		if (con->isAttached())
+			con->onFrame();
 
 		if (s->xs->sp < s->xs->fp)
 			error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
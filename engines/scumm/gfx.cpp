@@ -215,22 +215,38 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_roomStripCache.image = 0;
+	_roomStripCache.room = 0;
+	_roomStripCache.height = 0;
+	_roomStripCache.numZBuffer = 0;
+	memset(_roomStripCache.palette, 0, sizeof(_roomStripCache.palette));
+	_roomStripCache.size = 0;
+	_roomStripCacheDisabled = false;
 }
 
 Gdi::~Gdi() {
+	clearRoomStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
+	// HE games draw on top of the room image, and TMSK masks depend on
+	// the mask contents before decoding.
+	_roomStripCacheDisabled = true;
 }
 
 
 GdiNES::GdiNES(ScummEngine *vm) : Gdi(vm) {
 	memset(&_NES, 0, sizeof(_NES));
+	// Strips are built from tiles decoded in roomChanged() already
+	_roomStripCacheDisabled = true;
 }
 
 #ifdef USE_RGB_COLOR
 GdiPCEngine::GdiPCEngine(ScummEngine *vm) : Gdi(vm) {
 	memset(&_PCE, 0, sizeof(_PCE));
+	// Strips are built from tiles decoded in roomChanged() already
+	_roomStripCacheDisabled = true;
 }
 
 GdiPCEngine::~GdiPCEngine() {
@@ -242,10 +258,14 @@ GdiPCEngine::~GdiPCEngine() {
 
 GdiV1::GdiV1(ScummEngine *vm) : Gdi(vm) {
 	memset(&_V1, 0, sizeof(_V1));
+	// Strips are built from tiles decoded in roomChanged() already
+	_roomStripCacheDisabled = true;
 }
 
 GdiV2::GdiV2(ScummEngine *vm) : Gdi(vm) {
 	_roomStrips = 0;
+	// The whole bitmap is drawn by prepareDrawBitmap()
+	_roomStripCacheDisabled = true;
 }
 
 GdiV2::~GdiV2() {
@@ -275,6 +295,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearRoomStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -685,35 +706,15 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
+			const byte *srcPtr = (const byte *)src;
+			const byte *textPtr = (const byte *)text;
+			byte *dstPtr = _compositeBuf;
 
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
 			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
-				}
-				src32 += vsPitch;
-				text32 += textPitch;
+				composeTextRow(dstPtr, srcPtr, textPtr, width * m);
+				dstPtr += width * m;
+				srcPtr += width * m + vsPitch;
+				textPtr += _textSurface.pitch;
 			}
 #endif
 		}
@@ -776,16 +777,17 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 // EGA
 // monkey2 loom maniac monkey1 atlantis indy3 zak loomcd
 
-static const byte cgaDither[2][2][16] = {
-	{{0, 1, 0, 1, 2, 2, 0, 0, 3, 1, 3, 1, 3, 2, 1, 3},
-	 {0, 0, 1, 1, 0, 2, 2, 3, 0, 3, 1, 1, 3, 3, 1, 3}},
-	{{0, 0, 1, 1, 0, 2, 2, 3, 0, 3, 1, 1, 3, 3, 1, 3},
-	 {0, 1, 0, 1, 2, 2, 0, 0, 3, 1, 1, 1, 3, 2, 1, 3}}};
-
-// CGA dithers 4x4 square with direct substitutes
-// Odd lines have colors swapped, so there will be checkered patterns.
-// But apparently there is a mistake for 10th color.
 void ScummEngine::ditherCGA(byte *dst, int dstPitch, int x, int y, int width, int height) const {
+	// Substitutes for two adjacent pixels starting at an even column, indexed
+	// by the low nibbles of both pixels. This halves the number of lookups.
+	static byte cgaDitherPairs[2][256][2];
+	static bool cgaDitherPairsInitialized = false;
+
+	if (!cgaDitherPairsInitialized) {
+		buildCGADitherPairs(cgaDitherPairs);
+		cgaDitherPairsInitialized = true;
+	}
+
 	byte *ptr;
 	int idx1, idx2;
 
@@ -797,7 +799,21 @@ void ScummEngine::ditherCGA(byte *dst, int dstPitch, int x, int y, int width, in
 		else
 			idx1 = (y + y1) % 2;
 
-		for (int x1 = 0; x1 < width; x1++) {
+		int x1 = 0;
+		if ((x % 2) && width > 0) {
+			*ptr = cgaDither[idx1][1][*ptr & 0xF];
+			ptr++;
+			x1++;
+		}
+
+		for (; x1 + 2 <= width; x1 += 2) {
+			const byte *pair = cgaDitherPairs[idx1][(ptr[0] & 0xF) | ((ptr[1] & 0xF) << 4)];
+			ptr[0] = pair[0];
+			ptr[1] = pair[1];
+			ptr += 2;
+		}
+
+		for (; x1 < width; x1++) {
 			idx2 = (x + x1) % 2;
 			*ptr = cgaDither[idx1][idx2][*ptr & 0xF];
 			ptr++;
@@ -1008,7 +1024,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomBackground);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1795,6 +1811,8 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	const bool useStripCache = (flag & dbRoomBackground) && prepareRoomStripCache(ptr, y, height, numzbuf);
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1827,11 +1845,21 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		if (!useStripCache || !restoreRoomStrip(dstPtr, vs, x, y, height, stripnr, numzbuf, zplane_list)) {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+
+			// Transparent strips depend on what was drawn before
+			const bool cacheStrip = useStripCache && !transpStrip;
+
+			// COMI and HE games only uses flag value
+			if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
+				transpStrip = true;
 
-		// COMI and HE games only uses flag value
-		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
-			transpStrip = true;
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			if (cacheStrip)
+				storeRoomStrip(dstPtr, vs, x, y, height, stripnr, numzbuf, zplane_list);
+		}
 
 		if (vs->hasTwoBuffers) {
 			byte *frontBuf = (byte *)vs->getBasePtr(x * 8, y);
@@ -1841,8 +1869,6 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
-
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
 		for (int i = 0; i < numzbuf; i++) {
@@ -1869,6 +1895,110 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+#ifdef REDUCE_MEMORY_USAGE
+static const uint32 kRoomStripCacheBudget = 256 * 1024;
+#else
+static const uint32 kRoomStripCacheBudget = 2 * 1024 * 1024;
+#endif
+
+void Gdi::clearRoomStripCache() {
+	for (uint i = 0; i < _roomStripCache.strips.size(); i++)
+		free(_roomStripCache.strips[i]);
+	_roomStripCache.strips.clear();
+	_roomStripCache.image = 0;
+	_roomStripCache.size = 0;
+}
+
+/**
+ * Check whether the room strip cache can be used for drawing the given
+ * room image, and drop its contents if they were decoded for another one.
+ */
+bool Gdi::prepareRoomStripCache(const byte *ptr, int y, int height, int numzbuf) {
+	if (_roomStripCacheDisabled || y != 0)
+		return false;
+
+	// The room palette maps the colors while decoding, and is changed
+	// by scripts and palette fades on the Amiga.
+	if (ptr != _roomStripCache.image || _vm->_roomResource != _roomStripCache.room ||
+			height != _roomStripCache.height || numzbuf != _roomStripCache.numZBuffer ||
+			memcmp(_vm->_roomPalette, _roomStripCache.palette, sizeof(_roomStripCache.palette))) {
+		clearRoomStripCache();
+		_roomStripCache.image = ptr;
+		_roomStripCache.room = _vm->_roomResource;
+		_roomStripCache.height = height;
+		_roomStripCache.numZBuffer = numzbuf;
+		memcpy(_roomStripCache.palette, _vm->_roomPalette, sizeof(_roomStripCache.palette));
+	}
+
+	return true;
+}
+
+bool Gdi::restoreRoomStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+                int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0 || stripnr >= (int)_roomStripCache.strips.size() || !_roomStripCache.strips[stripnr])
+		return false;
+
+	const byte *src = _roomStripCache.strips[stripnr];
+	const int rowSize = 8 * vs->format.bytesPerPixel;
+
+	for (int h = 0; h < height; h++) {
+		memcpy(dstPtr, src, rowSize);
+		dstPtr += vs->pitch;
+		src += rowSize;
+	}
+
+	// Z-planes without data are left alone by decodeMask() as well
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++) {
+			*mask_ptr = *src++;
+			mask_ptr += _numStrips;
+		}
+	}
+
+	return true;
+}
+
+void Gdi::storeRoomStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+                int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	const int rowSize = 8 * vs->format.bytesPerPixel;
+	const uint32 size = (rowSize + MAX(numzbuf - 1, 0)) * height;
+
+	if (stripnr < 0 || _roomStripCache.size + size > kRoomStripCacheBudget)
+		return;
+
+	if (stripnr >= (int)_roomStripCache.strips.size())
+		_roomStripCache.strips.resize(stripnr + 1);
+	if (_roomStripCache.strips[stripnr])
+		return;
+
+	byte *dst = (byte *)malloc(size);
+	if (!dst)
+		return;
+	_roomStripCache.strips[stripnr] = dst;
+	_roomStripCache.size += size;
+
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, dstPtr, rowSize);
+		dstPtr += vs->pitch;
+		dst += rowSize;
+	}
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++) {
+			*dst++ = *mask_ptr;
+			mask_ptr += _numStrips;
+		}
+	}
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
@@ -24,10 +24,13 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
 
+#include "scumm/gfx_compose.h"
+
 namespace Scumm {
 
 class ScummEngine;
@@ -179,9 +182,6 @@ struct ColorCycle {
 
 struct StripTable;
 
-#define CHARSET_MASK_TRANSPARENCY	 0xFD
-#define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
-
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -197,6 +197,24 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * Decoded strips of the room background, together with their z-plane
+	 * masks. drawBitmap() fills it when called with dbRoomBackground, so
+	 * that strips scrolling back into view only have to be copied.
+	 */
+	struct RoomStripCache {
+		Common::Array<byte *> strips;	///< indexed by strip number, 0 if not decoded yet
+		const byte *image;	///< room image the strips were decoded from
+		int room;
+		int height;
+		int numZBuffer;
+		byte palette[256];	///< room palette the strips were decoded with
+		uint32 size;	///< total size of the decoded strips, in bytes
+	} _roomStripCache;
+
+	/** Set by subclasses which cannot reproduce a strip from its decoded pixels and masks. */
+	bool _roomStripCacheDisabled;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -232,6 +250,13 @@ protected:
 	/* Misc */
 	int getZPlanes(const byte *smap_ptr, const byte *zplane_list[9], bool bmapImage) const;
 
+	/* Room background strip cache */
+	bool prepareRoomStripCache(const byte *ptr, int y, int height, int numzbuf);
+	bool restoreRoomStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9]);
+	void storeRoomStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9]);
+
 	virtual bool drawStrip(byte *dstPtr, VirtScreen *vs,
 					int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr);
@@ -267,10 +292,14 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	/** Free all decoded room background strips. */
+	void clearRoomStripCache();
+
 	enum DrawBitmapFlags {
-		dbAllowMaskOr   = 1 << 0,
-		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbAllowMaskOr    = 1 << 0,
+		dbDrawMaskOnAll  = 1 << 1,
+		dbObjectMode     = 2 << 2,
+		dbRoomBackground = 1 << 4	///< full height strips of the room image, see RoomStripCache
 	};
 };
 
@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_GFX_COMPOSE_H
+#define SCUMM_GFX_COMPOSE_H
+
+#include "common/scummsys.h"
+
+#if defined(__SSE2__)
+#define SCUMM_GFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#define CHARSET_MASK_TRANSPARENCY	 0xFD
+#define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
+
+namespace Scumm {
+
+/**
+ * Compose one row of the text surface over the game graphics, four pixels
+ * at a time. Pixels of the text surface with value CHARSET_MASK_TRANSPARENCY
+ * show the game graphics.
+ * The width has to be a multiple of 4, and all rows have to be 4 byte aligned.
+ */
+inline void composeTextRow4(byte *dst, const byte *src, const byte *text, int width) {
+	const uint32 *src32 = (const uint32 *)src;
+	const uint32 *text32 = (const uint32 *)text;
+	uint32 *dst32 = (uint32 *)dst;
+
+	for (; width > 0; width -= 4) {
+		uint32 temp = *text32++;
+
+		// Generate a byte mask for those text pixels (bytes) with
+		// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+		// in mask will be either equal to 0x00 or 0xFF.
+		// Doing it this way avoids branches and bytewise operations,
+		// at the cost of readability ;).
+		uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+		mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+		mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+		// The following line is equivalent to this code:
+		//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+		// However, some compilers can generate somewhat better
+		// machine code for this equivalent statement:
+		*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+	}
+}
+
+/**
+ * Compose one row of the text surface over the game graphics. With SSE2,
+ * 16 pixels are handled per step, and composeTextRow4() does the rest.
+ * The same restrictions as for composeTextRow4() apply.
+ */
+inline void composeTextRow(byte *dst, const byte *src, const byte *text, int width) {
+#if defined(SCUMM_GFX_SSE2)
+	const __m128i transparent = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+	for (; width >= 16; width -= 16) {
+		const __m128i t = _mm_loadu_si128((const __m128i *)text);
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		const __m128i mask = _mm_cmpeq_epi8(t, transparent);
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, t)));
+		dst += 16;
+		src += 16;
+		text += 16;
+	}
+#endif
+
+	composeTextRow4(dst, src, text, width);
+}
+
+// CGA dithers 4x4 square with direct substitutes
+// Odd lines have colors swapped, so there will be checkered patterns.
+// But apparently there is a mistake for 10th color.
+static const byte cgaDither[2][2][16] = {
+	{{0, 1, 0, 1, 2, 2, 0, 0, 3, 1, 3, 1, 3, 2, 1, 3},
+	 {0, 0, 1, 1, 0, 2, 2, 3, 0, 3, 1, 1, 3, 3, 1, 3}},
+	{{0, 0, 1, 1, 0, 2, 2, 3, 0, 3, 1, 1, 3, 3, 1, 3},
+	 {0, 1, 0, 1, 2, 2, 0, 0, 3, 1, 1, 1, 3, 2, 1, 3}}};
+
+/**
+ * Fill the substitutes for two adjacent pixels starting at an even column.
+ * pairs[row][(left & 0xF) | ((right & 0xF) << 4)] holds the dithered left
+ * and right pixel for the given row of cgaDither.
+ */
+inline void buildCGADitherPairs(byte pairs[2][256][2]) {
+	for (int i = 0; i < 2; i++) {
+		for (int c = 0; c < 256; c++) {
+			pairs[i][c][0] = cgaDither[i][0][c & 0xF];
+			pairs[i][c][1] = cgaDither[i][1][c >> 4];
+		}
+	}
+}
+
+} // End of namespace Scumm
+
+#endif
@@ -45,6 +45,12 @@ BundleDirCache::~BundleDirCache() {
 		free(_budleDirCache[fileId].bundleTable);
 		free(_budleDirCache[fileId].indexTable);
 	}
+
+	for (CompTableMap::iterator i = _compTables.begin(); i != _compTables.end(); ++i)
+		free(i->_value.table);
+
+	for (BlockMap::iterator i = _blocks.begin(); i != _blocks.end(); ++i)
+		free(i->_value.data);
 }
 
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
@@ -63,6 +69,69 @@ bool BundleDirCache::isSndDataExtComp(int slot) {
 	return _budleDirCache[slot].isCompressed;
 }
 
+BundleDirCache::CompTable *BundleDirCache::getCompTable(int slot, int32 index, int32 &numItems, int32 &maxSize) {
+	CompTableMap::iterator i = _compTables.find(makeSoundKey(slot, index));
+	if (i == _compTables.end())
+		return NULL;
+
+	numItems = i->_value.numItems;
+	maxSize = i->_value.maxSize;
+	return i->_value.table;
+}
+
+void BundleDirCache::addCompTable(int slot, int32 index, CompTable *table, int32 numItems, int32 maxSize) {
+	const uint32 key = makeSoundKey(slot, index);
+	if (_compTables.contains(key) && _compTables[key].table != table)
+		free(_compTables[key].table);
+
+	CompTableEntry &entry = _compTables[key];
+	entry.table = table;
+	entry.numItems = numItems;
+	entry.maxSize = maxSize;
+}
+
+const byte *BundleDirCache::getBlock(int slot, int32 index, int32 block, int32 &size) {
+	BlockMap::iterator i = _blocks.find(BlockKey(makeSoundKey(slot, index), block));
+	if (i == _blocks.end())
+		return NULL;
+
+	// Move the block to the front of the LRU list
+	_blockLRU.erase(i->_value.lruPos);
+	_blockLRU.push_front(i->_key);
+	i->_value.lruPos = _blockLRU.begin();
+
+	size = i->_value.size;
+	return i->_value.data;
+}
+
+bool BundleDirCache::hasBlock(int slot, int32 index, int32 block) const {
+	return _blocks.contains(BlockKey(makeSoundKey(slot, index), block));
+}
+
+void BundleDirCache::addBlock(int slot, int32 index, int32 block, byte *data, int32 size) {
+	const BlockKey key(makeSoundKey(slot, index), block);
+
+	BlockMap::iterator i = _blocks.find(key);
+	if (i != _blocks.end()) {
+		free(i->_value.data);
+		_blockLRU.erase(i->_value.lruPos);
+		_blocks.erase(i);
+	}
+
+	while (_blocks.size() >= kMaxCachedBlocks) {
+		const BlockKey oldest = _blockLRU.back();
+		_blockLRU.pop_back();
+		free(_blocks[oldest].data);
+		_blocks.erase(oldest);
+	}
+
+	_blockLRU.push_front(key);
+	CachedBlock &entry = _blocks[key];
+	entry.data = data;
+	entry.size = size;
+	entry.lruPos = _blockLRU.begin();
+}
+
 int BundleDirCache::matchFile(const char *filename) {
 	int32 tag, offset;
 	bool found = false;
@@ -147,8 +216,11 @@ BundleMgr::BundleMgr(BundleDirCache *cache) {
 	_numCompItems = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_slot = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
+	_compInputBuffSize = 0;
+	_nextBlock = -1;
 }
 
 BundleMgr::~BundleMgr() {
@@ -184,17 +256,16 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 		return false;
 	}
 
-	int slot = _cache->matchFile(filename);
-	assert(slot != -1);
-	compressed = _cache->isSndDataExtComp(slot);
-	_numFiles = _cache->getNumFiles(slot);
+	_slot = _cache->matchFile(filename);
+	assert(_slot != -1);
+	compressed = _cache->isSndDataExtComp(_slot);
+	_numFiles = _cache->getNumFiles(_slot);
 	assert(_numFiles);
-	_bundleTable = _cache->getTable(slot);
-	_indexTable = _cache->getIndexTable(slot);
+	_bundleTable = _cache->getTable(_slot);
+	_indexTable = _cache->getIndexTable(_slot);
 	assert(_bundleTable);
 	_compTableLoaded = false;
-	_outputSize = 0;
-	_lastBlock = -1;
+	_nextBlock = -1;
 
 	return true;
 }
@@ -206,46 +277,91 @@ void BundleMgr::close() {
 		_numFiles = 0;
 		_numCompItems = 0;
 		_compTableLoaded = false;
-		_lastBlock = -1;
-		_outputSize = 0;
+		_nextBlock = -1;
 		_curSampleId = -1;
-		free(_compTable);
+		_slot = -1;
+		// The comp table is owned by the bundle dir cache
 		_compTable = NULL;
 		free(_compInputBuff);
 		_compInputBuff = NULL;
+		_compInputBuffSize = 0;
 	}
 }
 
 bool BundleMgr::loadCompTable(int32 index) {
-	_file->seek(_bundleTable[index].offset, SEEK_SET);
-	uint32 tag = _file->readUint32BE();
-	_numCompItems = _file->readUint32BE();
-	assert(_numCompItems > 0);
-	_file->seek(8, SEEK_CUR);
-
-	if (tag != MKTAG('C','O','M','P')) {
-		error("BundleMgr::loadCompTable() Compressed sound %d (%s:%d) invalid (%s)", index, _file->getName(), _bundleTable[index].offset, tag2str(tag));
-		return false;
-	}
-
-	_compTable = (CompTable *)malloc(sizeof(CompTable) * _numCompItems);
-	assert(_compTable);
 	int32 maxSize = 0;
-	for (int i = 0; i < _numCompItems; i++) {
-		_compTable[i].offset = _file->readUint32BE();
-		_compTable[i].size = _file->readUint32BE();
-		_compTable[i].codec = _file->readUint32BE();
-		_file->seek(4, SEEK_CUR);
-		if (_compTable[i].size > maxSize)
-			maxSize = _compTable[i].size;
+	_compTable = _cache->getCompTable(_slot, index, _numCompItems, maxSize);
+
+	if (!_compTable) {
+		_file->seek(_bundleTable[index].offset, SEEK_SET);
+		uint32 tag = _file->readUint32BE();
+		_numCompItems = _file->readUint32BE();
+		assert(_numCompItems > 0);
+		_file->seek(8, SEEK_CUR);
+
+		if (tag != MKTAG('C','O','M','P')) {
+			error("BundleMgr::loadCompTable() Compressed sound %d (%s:%d) invalid (%s)", index, _file->getName(), _bundleTable[index].offset, tag2str(tag));
+			return false;
+		}
+
+		_compTable = (CompTable *)malloc(sizeof(CompTable) * _numCompItems);
+		assert(_compTable);
+		for (int i = 0; i < _numCompItems; i++) {
+			_compTable[i].offset = _file->readUint32BE();
+			_compTable[i].size = _file->readUint32BE();
+			_compTable[i].codec = _file->readUint32BE();
+			_file->seek(4, SEEK_CUR);
+			if (_compTable[i].size > maxSize)
+				maxSize = _compTable[i].size;
+		}
+
+		_cache->addCompTable(_slot, index, _compTable, _numCompItems, maxSize);
 	}
+
 	// CMI hack: one more byte at the end of input buffer
-	_compInputBuff = (byte *)malloc(maxSize + 1);
-	assert(_compInputBuff);
+	if (_compInputBuffSize < maxSize + 1) {
+		free(_compInputBuff);
+		_compInputBuffSize = maxSize + 1;
+		_compInputBuff = (byte *)malloc(_compInputBuffSize);
+		assert(_compInputBuff);
+	}
 
 	return true;
 }
 
+const byte *BundleMgr::getBlock(int32 index, int32 block, int32 &outputSize) {
+	const byte *data = _cache->getBlock(_slot, index, block, outputSize);
+	if (data)
+		return data;
+
+	byte *output = (byte *)malloc(BundleDirCache::kBlockSize);
+	assert(output);
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	outputSize = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, output, _compTable[block].size);
+	if (outputSize > BundleDirCache::kBlockSize) {
+		error("_outputSize: %d", outputSize);
+	}
+
+	_cache->addBlock(_slot, index, block, output, outputSize);
+	return output;
+}
+
+void BundleMgr::prefetchBlocks(int numBlocks) {
+	if (!_file->isOpen() || !_compTableLoaded || _curSampleId == -1 || _nextBlock < 0)
+		return;
+
+	for (int block = _nextBlock; block < _numCompItems && block < _nextBlock + numBlocks; block++) {
+		if (!_cache->hasBlock(_slot, _curSampleId, block)) {
+			int32 outputSize;
+			getBlock(_curSampleId, block, outputSize);
+		}
+	}
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside);
 }
@@ -287,19 +403,8 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	skip = (offset + headerSize) % 0x2000;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
-			_lastBlock = i;
-		}
-
-		outputSize = _outputSize;
+		const byte *blockData = getBlock(index, i, outputSize);
+		_nextBlock = i + 1;
 
 		if (headerOutside) {
 			outputSize -= skip;
@@ -316,7 +421,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 		assert(finalSize + outputSize <= blocksFinalSize);
 
-		memcpy(*compFinal + finalSize, _compOutputBuff + skip, outputSize);
+		memcpy(*compFinal + finalSize, blockData + skip, outputSize);
 		finalSize += outputSize;
 
 		size -= outputSize;
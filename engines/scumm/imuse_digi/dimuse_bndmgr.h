@@ -25,6 +25,8 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/list.h"
 
 namespace Scumm {
 
@@ -43,6 +45,17 @@ public:
 		int32 index;
 	};
 
+	struct CompTable {
+		int32 offset;
+		int32 size;
+		int32 codec;
+	};
+
+	enum {
+		kBlockSize = 0x2000,
+		kMaxCachedBlocks = 128
+	};
+
 private:
 
 	struct FileDirCache {
@@ -53,6 +66,44 @@ private:
 		IndexNode *indexTable;
 	} _budleDirCache[4];
 
+	// The comp tables of all sounds ever played, so that reopening a
+	// sound does not have to read its table from the bundle again.
+	struct CompTableEntry {
+		CompTable *table;
+		int32 numItems;
+		int32 maxSize;
+	};
+	typedef Common::HashMap<uint32, CompTableEntry> CompTableMap;
+	CompTableMap _compTables;
+
+	// Decompressed blocks, shared by all BundleMgr instances using this
+	// cache, so that tracks playing the same sound and fades between
+	// tracks do not decompress a block more than once.
+	struct BlockKey {
+		uint32 sound;
+		int32 block;
+
+		BlockKey() : sound(0), block(0) {}
+		BlockKey(uint32 s, int32 b) : sound(s), block(b) {}
+		bool operator==(const BlockKey &key) const { return sound == key.sound && block == key.block; }
+	};
+
+	struct BlockKey_Hash {
+		uint operator()(const BlockKey &key) const { return key.sound * 31 + key.block; }
+	};
+
+	struct CachedBlock {
+		byte *data;
+		int32 size;
+		Common::List<BlockKey>::iterator lruPos;
+	};
+
+	typedef Common::HashMap<BlockKey, CachedBlock, BlockKey_Hash> BlockMap;
+	BlockMap _blocks;
+	Common::List<BlockKey> _blockLRU;
+
+	static uint32 makeSoundKey(int slot, int32 index) { return (slot << 24) | index; }
+
 public:
 	BundleDirCache();
 	~BundleDirCache();
@@ -62,17 +113,34 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	/**
+	 * Look up the comp table of a sound loaded earlier with addCompTable.
+	 * @return	the table, or NULL if the sound has not been seen yet
+	 */
+	CompTable *getCompTable(int slot, int32 index, int32 &numItems, int32 &maxSize);
+	void addCompTable(int slot, int32 index, CompTable *table, int32 numItems, int32 maxSize);
+
+	/**
+	 * Look up a decompressed block. The returned data stays valid until
+	 * the next call to addBlock.
+	 * @return	the block data, or NULL if the block is not cached
+	 */
+	const byte *getBlock(int slot, int32 index, int32 block, int32 &size);
+	/**
+	 * Store a decompressed block. The cache takes ownership of the data,
+	 * which must be allocated with malloc. The least recently used
+	 * block is dropped when the cache is full.
+	 */
+	void addBlock(int slot, int32 index, int32 block, byte *data, int32 size);
+	bool hasBlock(int slot, int32 index, int32 block) const;
 };
 
 class BundleMgr {
 
 private:
 
-	struct CompTable {
-		int32 offset;
-		int32 size;
-		int32 codec;
-	};
+	typedef BundleDirCache::CompTable CompTable;
 
 	BundleDirCache *_cache;
 	BundleDirCache::AudioTable *_bundleTable;
@@ -85,12 +153,13 @@ private:
 	BaseScummFile *_file;
 	bool _compTableLoaded;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
+	int _slot;
 	byte *_compInputBuff;
-	int _outputSize;
-	int _lastBlock;
+	int32 _compInputBuffSize;
+	int _nextBlock;
 
 	bool loadCompTable(int32 index);
+	const byte *getBlock(int32 index, int32 block, int32 &outputSize);
 
 public:
 
@@ -103,6 +172,13 @@ public:
 	int32 decompressSampleByName(const char *name, int32 offset, int32 size, byte **compFinal, bool headerOutside);
 	int32 decompressSampleByIndex(int32 index, int32 offset, int32 size, byte **compFinal, int header_size, bool headerOutside);
 	int32 decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside);
+
+	/**
+	 * Decompress up to numBlocks blocks following the ones last returned
+	 * by decompressSampleByIndex into the shared block cache, so that
+	 * they are available without delay when the track reaches them.
+	 */
+	void prefetchBlocks(int numBlocks);
 };
 
 } // End of namespace Scumm
@@ -192,6 +192,10 @@ void IMuseDigital::flushTracks() {
 		if (track->used && track->toBeRemoved && !_mixer->isSoundHandleActive(track->mixChanHandle)) {
 			debug(5, "flushTracks() - soundId:%d", track->soundId);
 			memset(track, 0, sizeof(Track));
+		} else if (track->used && !track->toBeRemoved && track->soundDesc) {
+			// Decompress the upcoming data of the track now, outside of
+			// the mixer callback
+			_sound->prefetchData(track->soundDesc);
 		}
 	}
 }
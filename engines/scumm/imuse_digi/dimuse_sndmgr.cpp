@@ -739,4 +739,13 @@ int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte
 	return size;
 }
 
+void ImuseDigiSndMgr::prefetchData(SoundDesc *soundDesc) {
+	assert(checkForProperHandle(soundDesc));
+
+	// Only bundles with blocks compressed by the iMUSE codecs benefit
+	// from having their next blocks decompressed ahead of time.
+	if (soundDesc->bundle && !soundDesc->compressed)
+		soundDesc->bundle->prefetchBlocks(2);
+}
+
 } // End of namespace Scumm
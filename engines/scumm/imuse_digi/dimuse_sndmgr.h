@@ -147,6 +147,7 @@ public:
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
 	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+	void prefetchData(SoundDesc *soundDesc);
 };
 
 } // End of namespace Scumm
@@ -100,6 +100,7 @@ MODULE_OBJS += \
 	smush/codec1.o \
 	smush/codec37.o \
 	smush/codec47.o \
+	smush/smush_decoder.o \
 	smush/imuse_channel.o \
 	smush/smush_player.o \
 	smush/saud_channel.o \
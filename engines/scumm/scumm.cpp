@@ -31,6 +31,7 @@
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
+#include "gui/EventRecorder.h"
 
 #include "graphics/cursorman.h"
 
@@ -2213,7 +2214,13 @@ load_game:
 	if (_game.heversion >= 80) {
 		((SoundHE *)_sound)->processSoundCode();
 	}
+#ifdef ENABLE_EVENTRECORDER
+	g_eventRec.beginBenchmarkSection(GUI::EventRecorder::kBenchmarkScript);
+#endif
 	runAllScripts();
+#ifdef ENABLE_EVENTRECORDER
+	g_eventRec.endBenchmarkSection(GUI::EventRecorder::kBenchmarkScript);
+#endif
 	checkExecVerbs();
 	checkAndRunSentenceScript();
 
@@ -0,0 +1,455 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+#include "common/zlib.h"
+
+#include "scumm/smush/codec37.h"
+#include "scumm/smush/codec47.h"
+#include "scumm/smush/smush_decoder.h"
+
+namespace Scumm {
+
+void smush_decode_codec1(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
+
+#ifdef USE_ZLIB
+/**
+ * Check the uncompressed size stored in front of a ZFOB chunk. It has to
+ * hold a frame object header, and zlib never compresses better than
+ * 1032:1, so anything larger than that is a corrupt size.
+ */
+static bool isValidFrameObjectSize(uint32 objSize, int32 subSize) {
+	return subSize > 4 && objSize >= 14 && objSize <= (uint64)(subSize - 4) * 1032;
+}
+#endif
+
+SmushDecoder::SmushDecoder(int speed) : _speed(speed), _videoTrack(0) {
+}
+
+SmushDecoder::~SmushDecoder() {
+	close();
+}
+
+bool SmushDecoder::loadStream(Common::SeekableReadStream *stream) {
+	close();
+	_videoTrack = 0;
+
+	SmushVideoTrack *track = new SmushVideoTrack(stream, _speed);
+	if (!track->isValid()) {
+		warning("SmushDecoder::loadStream(): No frame object found");
+		delete track;
+		return false;
+	}
+
+	_videoTrack = track;
+	addTrack(track);
+	return true;
+}
+
+void SmushDecoder::decodeAhead() {
+	if (isVideoLoaded() && _videoTrack)
+		_videoTrack->decodeAhead();
+}
+
+Common::SeekableReadStream *SmushDecoder::getFrameChunks() const {
+	if (!isVideoLoaded() || !_videoTrack)
+		return 0;
+
+	return _videoTrack->getFrameChunks();
+}
+
+bool SmushDecoder::isPictureChunk(uint32 type) {
+	switch (type) {
+	case MKTAG('N','P','A','L'):
+	case MKTAG('X','P','A','L'):
+	case MKTAG('F','O','B','J'):
+	case MKTAG('Z','F','O','B'):
+	case MKTAG('S','T','O','R'):
+	case MKTAG('F','T','C','H'):
+		return true;
+	default:
+		return false;
+	}
+}
+
+SmushDecoder::SmushVideoTrack::SmushVideoTrack(Common::SeekableReadStream *stream, int speed) : _decodeTask(this) {
+	_stream = stream;
+	_speed = speed;
+	_width = _height = 0;
+	_frameCount = 0;
+	_firstFrameOffset = 0;
+	_frontBuffer = _backBuffer = _storeBuffer = 0;
+	_codec37 = 0;
+	_codec47 = 0;
+
+	readHeader();
+
+	if (isValid()) {
+		_frontBuffer = (byte *)calloc(_width * _height, 1);
+		_backBuffer = (byte *)calloc(_width * _height, 1);
+		_surface.init(_width, _height, _width, _frontBuffer, getPixelFormat());
+		_nextFrameRead = readNextFrame();
+	}
+}
+
+SmushDecoder::SmushVideoTrack::~SmushVideoTrack() {
+	waitForDecode();
+	resetCodecs();
+	free(_frontBuffer);
+	free(_backBuffer);
+	free(_storeBuffer);
+	delete _stream;
+}
+
+void SmushDecoder::SmushVideoTrack::readHeader() {
+	_curFrame = -1;
+	_curChunks = 0;
+	_nextFrameRead = false;
+	_frameChunks[0].clear();
+	_frameChunks[1].clear();
+	_storeFrame = false;
+	_pictureDecoded = false;
+	_dirtyPalette = false;
+	_nextPaletteChanged = false;
+	memset(_palette, 0, sizeof(_palette));
+	memset(_deltaPal, 0, sizeof(_deltaPal));
+
+	_stream->seek(0);
+	_stream->readUint32BE(); // 'ANIM'
+	_stream->readUint32BE();
+
+	const uint32 tag = _stream->readUint32BE();
+	const int32 size = _stream->readUint32BE();
+	const int32 offset = _stream->pos();
+	if (tag != MKTAG('A','H','D','R') || size < 0x300 + 6) {
+		warning("SmushDecoder: Missing animation header");
+		return;
+	}
+
+	/* version = */ _stream->readUint16LE();
+	_frameCount = _stream->readUint16LE();
+	_stream->readUint16LE();
+	_stream->read(_palette, 0x300);
+	memcpy(_nextPalette, _palette, 0x300);
+	_dirtyPalette = true;
+
+	_firstFrameOffset = offset + size;
+	_stream->seek(_firstFrameOffset);
+
+	// The frame size is not part of the header, so take it from the
+	// first frame object of the first frame.
+	if (_width != 0 || _stream->readUint32BE() != MKTAG('F','R','M','E')) {
+		_stream->seek(_firstFrameOffset);
+		return;
+	}
+
+	int32 frameSize = _stream->readUint32BE();
+	while (frameSize > 0 && !_stream->eos()) {
+		const uint32 subType = _stream->readUint32BE();
+		const int32 subSize = _stream->readUint32BE();
+		const int32 subOffset = _stream->pos();
+
+		if (subType == MKTAG('F','O','B','J') && subSize >= 14) {
+			_stream->skip(6);
+			_width = _stream->readUint16LE();
+			_height = _stream->readUint16LE();
+			break;
+		}
+#ifdef USE_ZLIB
+		if (subType == MKTAG('Z','F','O','B') && subSize > 4 && subSize <= frameSize - 8) {
+			byte *chunk = (byte *)malloc(subSize);
+			unsigned long objSize = 0;
+			if (chunk && _stream->read(chunk, subSize) == (uint32)subSize)
+				objSize = READ_BE_UINT32(chunk);
+			if (isValidFrameObjectSize(objSize, subSize)) {
+				byte *obj = (byte *)malloc(objSize);
+				if (obj && Common::uncompress(obj, &objSize, chunk + 4, subSize - 4) && objSize >= 14) {
+					_width = READ_LE_UINT16(obj + 6);
+					_height = READ_LE_UINT16(obj + 8);
+				}
+				free(obj);
+			}
+			free(chunk);
+			break;
+		}
+#endif
+
+		frameSize -= subSize + 8 + (subSize & 1);
+		_stream->seek(subOffset + subSize + (subSize & 1));
+	}
+
+	_stream->seek(_firstFrameOffset);
+}
+
+bool SmushDecoder::SmushVideoTrack::readNextFrame() {
+	Common::Array<byte> &chunks = _frameChunks[_curChunks ^ 1];
+
+	for (;;) {
+		const uint32 type = _stream->readUint32BE();
+		const int32 size = _stream->readUint32BE();
+		const int32 offset = _stream->pos();
+
+		if (_stream->eos() || offset >= _stream->size() || size < 0)
+			return false;
+
+		if (type == MKTAG('F','R','M','E')) {
+			chunks.resize(size);
+			if (size > 0)
+				_stream->read(chunks.begin(), size);
+			break;
+		}
+
+		if (type == MKTAG('A','H','D','R') && size >= 0x300 + 6) {
+			_stream->skip(6);
+			_stream->read(_nextPalette, 0x300);
+			_nextPaletteChanged = true;
+		} else {
+			warning("SmushDecoder: Unknown chunk %s at %x", tag2str(type), offset);
+		}
+		_stream->seek(offset + size);
+	}
+
+	return !_stream->err();
+}
+
+void SmushDecoder::SmushVideoTrack::waitForDecode() {
+	if (_decodeTask.getState() == Common::Task::kStateIdle)
+		return;
+
+	g_system->getThreadPool()->wait(&_decodeTask);
+
+	if (!_decodeWarning.empty()) {
+		warning("%s", _decodeWarning.c_str());
+		_decodeWarning.clear();
+	}
+}
+
+void SmushDecoder::SmushVideoTrack::resetCodecs() {
+	delete _codec37;
+	_codec37 = 0;
+	delete _codec47;
+	_codec47 = 0;
+}
+
+bool SmushDecoder::SmushVideoTrack::rewind() {
+	waitForDecode();
+	resetCodecs();
+	readHeader();
+
+	memset(_frontBuffer, 0, _width * _height);
+	memset(_backBuffer, 0, _width * _height);
+	free(_storeBuffer);
+	_storeBuffer = 0;
+
+	_nextFrameRead = readNextFrame();
+	return true;
+}
+
+void SmushDecoder::SmushVideoTrack::decodeAhead() {
+	if (!_nextFrameRead || _decodeTask.getState() != Common::Task::kStateIdle)
+		return;
+
+	_pictureDecoded = false;
+	g_system->getThreadPool()->submit(&_decodeTask);
+}
+
+const Graphics::Surface *SmushDecoder::SmushVideoTrack::decodeNextFrame() {
+	if (!_nextFrameRead)
+		return &_surface;
+
+	decodeAhead();
+	waitForDecode();
+
+	// Frames without a picture keep showing the previous one
+	if (_pictureDecoded)
+		swapBuffers();
+
+	_curFrame++;
+	_curChunks ^= 1;
+
+	if (_nextPaletteChanged) {
+		memcpy(_palette, _nextPalette, 0x300);
+		_dirtyPalette = true;
+		_nextPaletteChanged = false;
+	}
+
+	_nextFrameRead = readNextFrame();
+	return &_surface;
+}
+
+Common::SeekableReadStream *SmushDecoder::SmushVideoTrack::getFrameChunks() const {
+	const Common::Array<byte> &chunks = _frameChunks[_curChunks];
+	return new Common::MemoryReadStream(chunks.begin(), chunks.size());
+}
+
+void SmushDecoder::SmushVideoTrack::swapBuffers() {
+	SWAP(_frontBuffer, _backBuffer);
+	_surface.setPixels(_frontBuffer);
+}
+
+void SmushDecoder::SmushVideoTrack::decodeFrame() {
+	const Common::Array<byte> &chunks = _frameChunks[_curChunks ^ 1];
+	const byte *data = chunks.begin();
+	int32 frameSize = chunks.size();
+
+	while (frameSize >= 8) {
+		const uint32 subType = READ_BE_UINT32(data);
+		const int32 subSize = READ_BE_UINT32(data + 4);
+		data += 8;
+		frameSize -= 8;
+
+		if (subSize < 0 || subSize > frameSize) {
+			_decodeWarning = Common::String::format("SmushDecoder: Truncated %s chunk in frame %d", tag2str(subType), _curFrame + 1);
+			return;
+		}
+
+		switch (subType) {
+		case MKTAG('N','P','A','L'):
+			if (subSize >= 0x300) {
+				memcpy(_nextPalette, data, 0x300);
+				_nextPaletteChanged = true;
+			}
+			break;
+		case MKTAG('X','P','A','L'):
+			handleDeltaPalette(data, subSize);
+			break;
+		case MKTAG('F','O','B','J'):
+			if (!handleFrameObject(data, subSize))
+				return;
+			break;
+#ifdef USE_ZLIB
+		case MKTAG('Z','F','O','B'): {
+			unsigned long objSize = subSize > 4 ? READ_BE_UINT32(data) : 0;
+			byte *obj = isValidFrameObjectSize(objSize, subSize) ? (byte *)malloc(objSize) : 0;
+			if (!obj || !Common::uncompress(obj, &objSize, data + 4, subSize - 4)) {
+				// Don't show a partially decoded frame
+				_decodeWarning = Common::String::format("SmushDecoder: Corrupt ZFOB chunk in frame %d", _curFrame + 1);
+				_pictureDecoded = false;
+				free(obj);
+				return;
+			}
+			const bool decoded = handleFrameObject(obj, objSize);
+			free(obj);
+			if (!decoded)
+				return;
+			break;
+		}
+#endif
+		case MKTAG('S','T','O','R'):
+			_storeFrame = true;
+			break;
+		case MKTAG('F','T','C','H'):
+			if (_storeBuffer) {
+				memcpy(_backBuffer, _storeBuffer, _width * _height);
+				_pictureDecoded = true;
+			}
+			break;
+		default:
+			// Sound, text and INSANE chunks are left to the caller
+			break;
+		}
+
+		const int32 paddedSize = MIN(subSize + (subSize & 1), frameSize);
+		data += paddedSize;
+		frameSize -= paddedSize;
+	}
+}
+
+bool SmushDecoder::SmushVideoTrack::handleFrameObject(const byte *data, int32 size) {
+	if (size < 14)
+		return true;
+
+	const int codec = READ_LE_UINT16(data);
+	const int left = READ_LE_UINT16(data + 2);
+	const int top = READ_LE_UINT16(data + 4);
+	const int width = READ_LE_UINT16(data + 6);
+	const int height = READ_LE_UINT16(data + 8);
+	const byte *src = data + 14;
+
+	// Like SmushPlayer outside of INSANE, skip frame objects which don't
+	// cover the whole frame
+	if (left != 0 || top != 0 || width != _width || height != _height)
+		return true;
+
+	switch (codec) {
+	case 1:
+	case 3:
+		// Transparent pixels keep the previous frame
+		if (!_pictureDecoded)
+			memcpy(_backBuffer, _frontBuffer, _width * _height);
+		smush_decode_codec1(_backBuffer, src, left, top, width, height, _width);
+		break;
+	case 37:
+		if (!_codec37)
+			_codec37 = new Codec37Decoder(width, height);
+		_codec37->decode(_backBuffer, src);
+		break;
+	case 47:
+		if (!_codec47)
+			_codec47 = new Codec47Decoder(width, height);
+		_codec47->decode(_backBuffer, src);
+		break;
+	default:
+		_decodeWarning = Common::String::format("SmushDecoder: Invalid codec for frame object: %d", codec);
+		_pictureDecoded = false;
+		return false;
+	}
+
+	_pictureDecoded = true;
+
+	if (_storeFrame) {
+		if (!_storeBuffer)
+			_storeBuffer = (byte *)malloc(_width * _height);
+		memcpy(_storeBuffer, _backBuffer, _width * _height);
+		_storeFrame = false;
+	}
+
+	return true;
+}
+
+static byte deltaColor(byte orgColor, int16 delta) {
+	int t = (orgColor * 129 + delta) / 128;
+	return CLIP(t, 0, 255);
+}
+
+void SmushDecoder::SmushVideoTrack::handleDeltaPalette(const byte *data, int32 size) {
+	if (size == 0x300 * 3 + 4) {
+		for (int i = 0; i < 0x300; i++)
+			_deltaPal[i] = READ_LE_UINT16(data + 4 + i * 2);
+		memcpy(_nextPalette, data + 4 + 0x300 * 2, 0x300);
+	} else if (size == 6) {
+		for (int i = 0; i < 0x300; i++)
+			_nextPalette[i] = deltaColor(_nextPalette[i], _deltaPal[i]);
+	} else {
+		_decodeWarning = Common::String::format("SmushDecoder: Wrong size for delta palette: %d", size);
+		return;
+	}
+
+	_nextPaletteChanged = true;
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if !defined(SCUMM_SMUSH_DECODER_H) && defined(ENABLE_SCUMM_7_8)
+#define SCUMM_SMUSH_DECODER_H
+
+#include "common/array.h"
+#include "common/rational.h"
+#include "common/str.h"
+#include "common/threadpool.h"
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Scumm {
+
+class Codec37Decoder;
+class Codec47Decoder;
+
+/**
+ * Decoder for the video part of SMUSH (.san/.snm) animations.
+ *
+ * Only the picture and palette chunks (FOBJ, ZFOB, NPAL, XPAL, STOR and
+ * FTCH) are handled. The remaining chunks of the current frame, like
+ * sound (PSAD/IACT) and text (TRES/TEXT), can be retrieved with
+ * getFrameChunks() and have to be handled by the caller.
+ *
+ * Frames are decoded into one of two buffers. The surface returned by
+ * decodeNextFrame() points directly at the buffer holding the current
+ * frame, so it stays valid until the next call and must not be freed.
+ * decodeAhead() starts decoding the next frame into the other buffer on
+ * the thread pool, so that decodeNextFrame() only has to wait for it and
+ * swap the buffers.
+ */
+class SmushDecoder : public Video::VideoDecoder {
+public:
+	SmushDecoder(int speed = 15);
+	virtual ~SmushDecoder();
+
+	bool loadStream(Common::SeekableReadStream *stream);
+
+	/**
+	 * Start decoding the frame following the current one on the thread
+	 * pool, unless that has already been done. The current frame must
+	 * not be drawn on anymore after this.
+	 */
+	void decodeAhead();
+
+	/**
+	 * Return the chunks of the current frame, as found in its FRME chunk.
+	 * The stream is only valid until decodeNextFrame() is called again
+	 * and has to be deleted by the caller.
+	 */
+	Common::SeekableReadStream *getFrameChunks() const;
+
+	/**
+	 * Check whether a frame chunk is handled by the decoder itself.
+	 */
+	static bool isPictureChunk(uint32 type);
+
+private:
+	class SmushVideoTrack : public FixedRateVideoTrack {
+	public:
+		SmushVideoTrack(Common::SeekableReadStream *stream, int speed);
+		~SmushVideoTrack();
+
+		bool isValid() const { return _width != 0 && _height != 0; }
+
+		bool endOfTrack() const { return !_nextFrameRead; }
+		bool isRewindable() const { return true; }
+		bool rewind();
+
+		uint16 getWidth() const { return _width; }
+		uint16 getHeight() const { return _height; }
+		Graphics::PixelFormat getPixelFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+		int getCurFrame() const { return _curFrame; }
+		int getFrameCount() const { return _frameCount; }
+		const Graphics::Surface *decodeNextFrame();
+		const byte *getPalette() const { _dirtyPalette = false; return _palette; }
+		bool hasDirtyPalette() const { return _dirtyPalette; }
+
+		void decodeAhead();
+		Common::SeekableReadStream *getFrameChunks() const;
+
+	protected:
+		Common::Rational getFrameRate() const { return _speed; }
+
+	private:
+		class DecodeTask : public Common::Task {
+		public:
+			DecodeTask(SmushVideoTrack *track) : _track(track) {}
+			virtual void run() { _track->decodeFrame(); }
+
+		private:
+			SmushVideoTrack *_track;
+		};
+
+		Common::SeekableReadStream *_stream;
+		int32 _firstFrameOffset;
+		int _speed;
+		int _curFrame;
+		int _frameCount;
+		uint16 _width, _height;
+
+		// The FRME chunks of the current and the next frame. The next one
+		// is read from the stream as soon as the current one is shown.
+		Common::Array<byte> _frameChunks[2];
+		int _curChunks;
+		bool _nextFrameRead;
+
+		// The surface always refers to _frontBuffer. The next frame is
+		// decoded into _backBuffer, which is swapped in once that frame is
+		// shown. Frame objects with codec 37 or 47 overwrite the whole
+		// frame, so the current frame is only copied to the back buffer
+		// for the transparent codec 1.
+		Graphics::Surface _surface;
+		byte *_frontBuffer;
+		byte *_backBuffer;
+		byte *_storeBuffer;
+		bool _storeFrame;
+
+		// While the decode task is pending, it owns the back and store
+		// buffers, the codecs and the palette of the next frame. Warnings
+		// are passed on by decodeNextFrame(), as the task may run on
+		// another thread.
+		DecodeTask _decodeTask;
+		bool _pictureDecoded;
+		Common::String _decodeWarning;
+
+		// _nextPalette tracks the palette changes of the frames decoded so
+		// far. It is copied to _palette when the frame is actually shown.
+		byte _palette[0x300];
+		byte _nextPalette[0x300];
+		int16 _deltaPal[0x300];
+		mutable bool _dirtyPalette;
+		bool _nextPaletteChanged;
+
+		Codec37Decoder *_codec37;
+		Codec47Decoder *_codec47;
+
+		void readHeader();
+		bool readNextFrame();
+		void waitForDecode();
+		void resetCodecs();
+		void decodeFrame();
+		bool handleFrameObject(const byte *data, int32 size);
+		void handleDeltaPalette(const byte *data, int32 size);
+		void swapBuffers();
+	};
+
+	int _speed;
+	SmushVideoTrack *_videoTrack;
+};
+
+} // End of namespace Scumm
+
+#endif
@@ -41,6 +41,7 @@
 #include "scumm/smush/channel.h"
 #include "scumm/smush/codec37.h"
 #include "scumm/smush/codec47.h"
+#include "scumm/smush/smush_decoder.h"
 #include "scumm/smush/smush_font.h"
 #include "scumm/smush/smush_mixer.h"
 #include "scumm/smush/smush_player.h"
@@ -212,6 +213,7 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_nbframes = 0;
 	_codec37 = 0;
 	_codec47 = 0;
+	_decoder = 0;
 	_smixer = NULL;
 	_strings = NULL;
 	_sf[0] = NULL;
@@ -290,6 +292,9 @@ void SmushPlayer::release() {
 	delete _base;
 	_base = NULL;
 
+	delete _decoder;
+	_decoder = 0;
+
 	free(_specialBuffer);
 	_specialBuffer = NULL;
 
@@ -830,6 +835,49 @@ void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b
 	free(chunk_buffer);
 }
 
+void SmushPlayer::handleFrameChunk(uint32 subType, int32 subSize, Common::SeekableReadStream &b) {
+	switch (subType) {
+	case MKTAG('N','P','A','L'):
+		handleNewPalette(subSize, b);
+		break;
+	case MKTAG('F','O','B','J'):
+		handleFrameObject(subSize, b);
+		break;
+#ifdef USE_ZLIB
+	case MKTAG('Z','F','O','B'):
+		handleZlibFrameObject(subSize, b);
+		break;
+#endif
+	case MKTAG('P','S','A','D'):
+		if (!_compressedFileMode)
+			handleSoundFrame(subSize, b);
+		break;
+	case MKTAG('T','R','E','S'):
+		handleTextResource(subType, subSize, b);
+		break;
+	case MKTAG('X','P','A','L'):
+		handleDeltaPalette(subSize, b);
+		break;
+	case MKTAG('I','A','C','T'):
+		handleIACT(subSize, b);
+		break;
+	case MKTAG('S','T','O','R'):
+		handleStore(subSize, b);
+		break;
+	case MKTAG('F','T','C','H'):
+		handleFetch(subSize, b);
+		break;
+	case MKTAG('S','K','I','P'):
+		_vm->_insane->procSKIP(subSize, b);
+		break;
+	case MKTAG('T','E','X','T'):
+		handleTextResource(subType, subSize, b);
+		break;
+	default:
+		error("Unknown frame subChunk found : %s, %d", tag2str(subType), subSize);
+	}
+}
+
 void SmushPlayer::handleFrame(int32 frameSize, Common::SeekableReadStream &b) {
 	debugC(DEBUG_SMUSH, "SmushPlayer::handleFrame(%d)", _frame);
 	_skipNext = false;
@@ -842,46 +890,11 @@ void SmushPlayer::handleFrame(int32 frameSize, Common::SeekableReadStream &b) {
 		const uint32 subType = b.readUint32BE();
 		const int32 subSize = b.readUint32BE();
 		const int32 subOffset = b.pos();
-		switch (subType) {
-		case MKTAG('N','P','A','L'):
-			handleNewPalette(subSize, b);
-			break;
-		case MKTAG('F','O','B','J'):
-			handleFrameObject(subSize, b);
-			break;
-#ifdef USE_ZLIB
-		case MKTAG('Z','F','O','B'):
-			handleZlibFrameObject(subSize, b);
-			break;
-#endif
-		case MKTAG('P','S','A','D'):
-			if (!_compressedFileMode)
-				handleSoundFrame(subSize, b);
-			break;
-		case MKTAG('T','R','E','S'):
-			handleTextResource(subType, subSize, b);
-			break;
-		case MKTAG('X','P','A','L'):
-			handleDeltaPalette(subSize, b);
-			break;
-		case MKTAG('I','A','C','T'):
-			handleIACT(subSize, b);
-			break;
-		case MKTAG('S','T','O','R'):
-			handleStore(subSize, b);
-			break;
-		case MKTAG('F','T','C','H'):
-			handleFetch(subSize, b);
-			break;
-		case MKTAG('S','K','I','P'):
-			_vm->_insane->procSKIP(subSize, b);
-			break;
-		case MKTAG('T','E','X','T'):
-			handleTextResource(subType, subSize, b);
-			break;
-		default:
-			error("Unknown frame subChunk found : %s, %d", tag2str(subType), subSize);
-		}
+
+		// Picture and palette chunks of decoded frames have already been
+		// handled by the decoder
+		if (!_decoder || !SmushDecoder::isPictureChunk(subType))
+			handleFrameChunk(subType, subSize, b);
 
 		frameSize -= subSize + 8;
 		b.seek(subOffset + subSize, SEEK_SET);
@@ -998,6 +1011,11 @@ void SmushPlayer::parseNextFrame() {
 				// We need this in Full Throttle when entering/leaving
 				// the old mine road.
 				tryCmpFile(_seekFile.c_str());
+
+				// INSANE draws on the frames and seeks around in the
+				// file, so it keeps using the frame handling below
+				if (!_insanity)
+					loadDecoder();
 			}
 			_skipPalette = false;
 		} else {
@@ -1014,6 +1032,12 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
+	if (_decoder) {
+		parseDecodedFrame();
+		_vm->_imuseDigital->flushTracks();
+		return;
+	}
+
 	const uint32 subType = _base->readUint32BE();
 	const int32 subSize = _base->readUint32BE();
 	const int32 subOffset = _base->pos();
@@ -1045,6 +1069,51 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+void SmushPlayer::loadDecoder() {
+	ScummFile *file = new ScummFile();
+	if (!_vm->openFile(*file, _seekFile)) {
+		delete file;
+		return;
+	}
+
+	// Animations with frames of a different size than the screen, like
+	// the 384x242 ones of the Full Throttle demo, are not decoded ahead
+	_decoder = new SmushDecoder(_speed);
+	if (!_decoder->loadStream(file) || _decoder->getWidth() != _vm->_screenWidth || _decoder->getHeight() != _vm->_screenHeight) {
+		delete _decoder;
+		_decoder = 0;
+		return;
+	}
+
+	_nbframes = _decoder->getFrameCount();
+}
+
+void SmushPlayer::parseDecodedFrame() {
+	const Graphics::Surface *surface = _decoder->decodeNextFrame();
+	if (!surface) {
+		_vm->_smushVideoShouldFinish = true;
+		_endOfFile = true;
+		return;
+	}
+
+	if (_decoder->hasDirtyPalette())
+		setPalette(_decoder->getPalette());
+
+	// The frame is drawn and shown straight from the decoder's buffer
+	_dst = const_cast<byte *>((const byte *)surface->getPixels());
+	_width = surface->w;
+	_height = surface->h;
+
+	// Sound and subtitles are left to us
+	Common::SeekableReadStream *chunks = _decoder->getFrameChunks();
+	handleFrame(chunks->size(), *chunks);
+	delete chunks;
+
+	// Nothing is drawn on the frame anymore, so the next one can be
+	// decoded while this one is shown
+	_decoder->decodeAhead();
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
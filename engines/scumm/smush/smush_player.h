@@ -34,6 +34,7 @@ class SmushMixer;
 class StringResource;
 class Codec37Decoder;
 class Codec47Decoder;
+class SmushDecoder;
 
 class SmushPlayer {
 	friend class Insane;
@@ -47,6 +48,7 @@ private:
 	StringResource *_strings;
 	Codec37Decoder *_codec37;
 	Codec47Decoder *_codec47;
+	SmushDecoder *_decoder;
 	Common::SeekableReadStream *_base;
 	uint32 _baseSize;
 	byte *_frameBuffer;
@@ -111,6 +113,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void parseDecodedFrame();
+	void loadDecoder();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -120,6 +124,7 @@ private:
 	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height);
 	void handleAnimHeader(int32 subSize, Common::SeekableReadStream &);
 	void handleFrame(int32 frameSize, Common::SeekableReadStream &);
+	void handleFrameChunk(uint32 subType, int32 subSize, Common::SeekableReadStream &);
 	void handleNewPalette(int32 subSize, Common::SeekableReadStream &);
 #ifdef USE_ZLIB
 	void handleZlibFrameObject(int32 subSize, Common::SeekableReadStream &b);
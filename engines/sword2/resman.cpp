@@ -23,6 +23,8 @@
  */
 
 
+#include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/file.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -40,6 +42,9 @@
 
 #define Debug_Printf _vm->_debugger->debugPrintf
 
+// Number of memory blocks left for allocations other than resources
+#define RESERVED_MEM_BLOCKS 100
+
 namespace Sword2 {
 
 // Welcome to the easy resource manager - written in simple code for easy
@@ -64,23 +69,21 @@ struct CdInf {
 	uint8 cd;		// Cd cluster is on and whether it is on the local drive or not.
 };
 
-ResourceManager::ResourceManager(Sword2Engine *vm) {
+ResourceManager::ResourceManager(Sword2Engine *vm) : _cache(MAX_MEM_CACHE, evictResource, this) {
 	_vm = vm;
 
 	_totalClusters = 0;
 	_resList = NULL;
 	_resConvTable = NULL;
-	_cacheStart = NULL;
-	_cacheEnd = NULL;
-	_usedMem = 0;
+
+	if (ConfMan.hasKey("resource_cache_size"))
+		_cache.setBudget(ConfMan.getInt("resource_cache_size") * 1024);
 }
 
 ResourceManager::~ResourceManager() {
-	Resource *res = _cacheStart;
-	while (res) {
-		_vm->_memory->memFree(res->ptr);
-		res = res->next;
-	}
+	debug(1, "Resource cache: %d hits, %d misses, %d evictions", _cache.getHits(), _cache.getMisses(), _cache.getEvictions());
+
+	_cache.clear();
 	for (uint i = 0; i < _totalClusters; i++)
 		free(_resFiles[i].entryTab);
 	free(_resList);
@@ -247,7 +250,6 @@ bool ResourceManager::init() {
 		_resList[i].ptr = NULL;
 		_resList[i].size = 0;
 		_resList[i].refCount = 0;
-		_resList[i].prev = _resList[i].next = NULL;
 	}
 
 	return true;
@@ -268,7 +270,7 @@ byte *ResourceManager::openResource(uint32 res, bool dump) {
 
 	// Is the resource in memory already? If not, load it.
 
-	if (!_resList[res].ptr) {
+	if (!_cache.get(res)) {
 		// Fetch the correct file and read in the correct portion.
 		uint16 cluFileNum = _resConvTable[res * 2]; // points to the number of the ascii filename
 
@@ -309,6 +311,11 @@ byte *ResourceManager::openResource(uint32 res, bool dump) {
 
 		debug(6, "res len %d", len);
 
+		// The memory manager can only handle a limited number of blocks,
+		// so a large cache may have to make room for new ones as well.
+		while (_vm->_memory->getNumBlocks() >= MAX_MEMORY_BLOCKS - RESERVED_MEM_BLOCKS && _cache.evictOldest())
+			;
+
 		// Ok, we know the length so try and allocate the memory.
 		_resList[res].ptr = _vm->_memory->memAlloc(len, res);
 		_resList[res].size = len;
@@ -380,11 +387,10 @@ byte *ResourceManager::openResource(uint32 res, bool dump) {
 		file->close();
 		delete file;
 
-		_usedMem += len;
-		checkMemUsage();
-	} else if (_resList[res].refCount == 0)
-		removeFromCacheList(_resList + res);
+		_cache.insert(res, _resList[res].ptr, len);
+	}
 
+	_cache.pin(res);
 	_resList[res].refCount++;
 
 	return _resList[res].ptr;
@@ -402,8 +408,7 @@ void ResourceManager::closeResource(uint32 res) {
 	assert(_resList[res].refCount > 0);
 
 	_resList[res].refCount--;
-	if (_resList[res].refCount == 0)
-		addToCacheList(_resList + res);
+	_cache.unpin(res);
 
 	// It's tempting to free the resource immediately when refCount
 	// reaches zero, but that'd be a mistake. Closing a resource does not
@@ -416,28 +421,13 @@ void ResourceManager::closeResource(uint32 res) {
 	// specific memory address - was considered a bad thing.
 }
 
-void ResourceManager::removeFromCacheList(Resource *res) {
-	if (_cacheStart == res)
-		_cacheStart = res->next;
-
-	if (_cacheEnd == res)
-		_cacheEnd = res->prev;
-
-	if (res->prev)
-		res->prev->next = res->next;
-	if (res->next)
-		res->next->prev = res->prev;
-	res->prev = res->next = NULL;
-}
+void ResourceManager::evictResource(const uint32 &res, byte *&ptr, void *refCon) {
+	ResourceManager *resman = (ResourceManager *)refCon;
 
-void ResourceManager::addToCacheList(Resource *res) {
-	res->prev = NULL;
-	res->next = _cacheStart;
-	if (_cacheStart)
-		_cacheStart->prev = res;
-	_cacheStart = res;
-	if (!_cacheEnd)
-		_cacheEnd = res;
+	assert(resman->_resList[res].ptr == ptr);
+	resman->_vm->_memory->memFree(ptr);
+	resman->_resList[res].ptr = NULL;
+	resman->_resList[res].refCount = 0;
 }
 
 Common::File *ResourceManager::openCluFile(uint16 fileNum) {
@@ -557,35 +547,9 @@ uint32 ResourceManager::fetchLen(uint32 res) {
 	return _resFiles[parent_res_file].entryTab[actual_res * 2 + 1];
 }
 
-void ResourceManager::checkMemUsage() {
-	while (_usedMem > MAX_MEM_CACHE) {
-		// we're using up more memory than we wanted to. free some old stuff.
-		// Newly loaded objects are added to the start of the list,
-		// we start freeing from the end, to free the oldest items first
-		if (_cacheEnd) {
-			Resource *tmp = _cacheEnd;
-			assert((tmp->refCount == 0) && (tmp->ptr) && (tmp->next == NULL));
-			removeFromCacheList(tmp);
-
-			_vm->_memory->memFree(tmp->ptr);
-			tmp->ptr = NULL;
-			_usedMem -= tmp->size;
-		} else {
-			warning("%d bytes of memory used, but cache list is empty", _usedMem);
-			return;
-		}
-	}
-}
-
 void ResourceManager::remove(int res) {
-	if (_resList[res].ptr) {
-		removeFromCacheList(_resList + res);
-
-		_vm->_memory->memFree(_resList[res].ptr);
-		_resList[res].ptr = NULL;
-		_resList[res].refCount = 0;
-		_usedMem -= _resList[res].size;
-	}
+	// The cache frees the memory through evictResource()
+	_cache.remove(res);
 }
 
 /**
@@ -25,11 +25,15 @@
 #ifndef	SWORD2_RESMAN_H
 #define	SWORD2_RESMAN_H
 
+#include "common/resource-cache.h"
+
 namespace Common {
 class File;
 }
 
-#define MAX_MEM_CACHE (8 * 1024 * 1024) // we keep up to 8 megs of resource data files in memory
+// By default, we keep up to 8 megs of unused resource data files in memory.
+// This can be changed with the "resource_cache_size" setting (in kilobytes).
+#define MAX_MEM_CACHE (8 * 1024 * 1024)
 #define	MAX_res_files 20
 
 namespace Sword2 {
@@ -40,7 +44,6 @@ struct Resource {
 	byte *ptr;
 	uint32 size;
 	uint32 refCount;
-	Resource *next, *prev;
 };
 
 struct ResourceFile {
@@ -54,9 +57,8 @@ class ResourceManager {
 private:
 	Common::File *openCluFile(uint16 fileNum);
 	void readCluIndex(uint16 fileNum, Common::File *file);
-	void removeFromCacheList(Resource *res);
-	void addToCacheList(Resource *res);
-	void checkMemUsage();
+
+	static void evictResource(const uint32 &res, byte *&ptr, void *refCon);
 
 	Sword2Engine *_vm;
 
@@ -70,8 +72,9 @@ private:
 	ResourceFile _resFiles[MAX_res_files];
 	Resource *_resList;
 
-	Resource *_cacheStart, *_cacheEnd;
-	uint32 _usedMem; // amount of used memory in bytes
+	// Loaded resources. Open resources are pinned, closed ones are kept
+	// until they have to make room for others.
+	Common::ResourceCache<uint32, byte *> _cache;
 
 public:
 	ResourceManager(Sword2Engine *vm);	// read in the config file
@@ -22,14 +22,73 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/gfx/graphicengine.h"
+#include "sword25/gfx/renderobjectmanager.h"
+#include "sword25/script/luascript.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("lua_gc", WRAP_METHOD(Sword25Console, Cmd_LuaGC));
+	registerCmd("render_stats", WRAP_METHOD(Sword25Console, Cmd_RenderStats));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_LuaGC(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		script->resetGCStatistics();
+		debugPrintf("Lua garbage collection statistics reset\n");
+		return true;
+	}
+
+	if (argc > 2) {
+		int value = atoi(argv[2]);
+		if (!strcmp(argv[1], "pause")) {
+			script->setGCPause(value);
+		} else if (!strcmp(argv[1], "stepmul")) {
+			script->setGCStepMultiplier(value);
+		} else if (!strcmp(argv[1], "budget")) {
+			script->setGCFrameBudget(value);
+		} else {
+			debugPrintf("Usage: %s [reset | pause <percent> | stepmul <percent> | budget <ms>]\n", argv[0]);
+			return true;
+		}
+	}
+
+	const LuaScriptEngine::GCStatistics &stats = script->getGCStatistics();
+	debugPrintf("Memory in use: %d KB\n", script->getMemoryUsage());
+	debugPrintf("Pause: %d%%, step multiplier: %d%%, frame budget: %d ms\n",
+		script->getGCPause(), script->getGCStepMultiplier(), script->getGCFrameBudget());
+	debugPrintf("Frame steps: %d (%d cycles finished), %d ms total, %d ms max per frame\n",
+		stats.frameSteps, stats.frameCycles, stats.frameTime, stats.maxFrameTime);
+	debugPrintf("Full collections: %d, %d ms total\n", stats.fullCollections, stats.fullTime);
+	return true;
+}
+
+bool Sword25Console::Cmd_RenderStats(int argc, const char **argv) {
+	RenderObjectManager *manager = Kernel::getInstance()->getGfx()->getRenderObjectManager();
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		manager->resetStatistics();
+		debugPrintf("Render statistics reset\n");
+		return true;
+	}
+
+	const RenderObjectManager::RenderStatistics &stats = manager->getStatistics();
+	debugPrintf("Last frame: %d pixels in %d rectangles\n", manager->getLastDirtyArea(), manager->getLastDirtyRectCount());
+	debugPrintf("Frames: %d (%d unchanged)\n", stats.frames, stats.skippedFrames);
+	if (stats.frames) {
+		debugPrintf("Average per frame: %d pixels in %d rectangles\n",
+			(int)(stats.dirtyArea / stats.frames), stats.dirtyRects / stats.frames);
+	}
+	return true;
+}
+
 } // End of namespace Sword25
@@ -42,6 +42,7 @@
 #include "sword25/gfx/image/swimage.h"
 #include "sword25/gfx/image/vectorimage.h"
 #include "sword25/package/packagemanager.h"
+#include "sword25/script/script.h"
 #include "sword25/kernel/inputpersistenceblock.h"
 #include "sword25/kernel/outputpersistenceblock.h"
 
@@ -148,6 +149,9 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	// Use the rest of the frame for incremental work of the scripts
+	Kernel::getInstance()->getScript()->endFrame();
+
 	return true;
 }
 
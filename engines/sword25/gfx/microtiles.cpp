@@ -22,9 +22,11 @@
 
 #include "sword25/gfx/microtiles.h"
 
+#include "common/array.h"
+
 namespace Sword25 {
 
-MicroTileArray::MicroTileArray(int16 width, int16 height) {
+MicroTileArray::MicroTileArray(int16 width, int16 height) : _width(width), _height(height) {
 	_tilesW = (width / TileSize) + ((width % TileSize) > 0 ? 1 : 0);
 	_tilesH = (height / TileSize) + ((height % TileSize) > 0 ? 1 : 0);
 	_tiles = new BoundingBox[_tilesW * _tilesH];
@@ -41,17 +43,20 @@ void MicroTileArray::addRect(Common::Rect r) {
 	int tx0, ty0, tx1, ty1;
 	int ix0, iy0, ix1, iy1;
 
-	r.clip(Common::Rect(0, 0, 799, 599));
+	r.clip(Common::Rect(0, 0, _width, _height));
+	if (r.isEmpty())
+		return;
 
+	// The bottom and right edges are exclusive, the tiles store inclusive ones
 	ux0 = r.left / TileSize;
 	uy0 = r.top / TileSize;
-	ux1 = r.right / TileSize;
-	uy1 = r.bottom / TileSize;
+	ux1 = (r.right - 1) / TileSize;
+	uy1 = (r.bottom - 1) / TileSize;
 
 	tx0 = r.left % TileSize;
 	ty0 = r.top % TileSize;
-	tx1 = r.right % TileSize;
-	ty1 = r.bottom % TileSize;
+	tx1 = (r.right - 1) % TileSize;
+	ty1 = (r.bottom - 1) % TileSize;
 
 	for (int yc = uy0; yc <= uy1; yc++) {
 		for (int xc = ux0; xc <= ux1; xc++) {
@@ -111,6 +116,12 @@ RectangleList *MicroTileArray::getRectangles() {
 
 	RectangleList *rects = new RectangleList();
 
+	// Rectangles which end at the bottom of the previous and current tile
+	// row. Rectangles of the current row which span exactly the same columns
+	// as one of the previous row are merged into it, so that large dirty
+	// areas are handed out as few rectangles as possible.
+	Common::Array<RectangleList::iterator> prevRow, currRow;
+
 	int x, y;
 	int x0, y0, x1, y1;
 	int i = 0;
@@ -148,10 +159,29 @@ RectangleList *MicroTileArray::getRectangles() {
 
 			x1 = (x * TileSize) + TileX1(_tiles[i]);
 
-			rects->push_back(Common::Rect(x0, y0, x1 + 1, y1 + 1));
+			Common::Rect rect(x0, y0, x1 + 1, y1 + 1);
+			bool merged = false;
+			for (uint j = 0; j < prevRow.size(); ++j) {
+				Common::Rect &prev = *prevRow[j];
+				if (prev.left == rect.left && prev.right == rect.right && prev.bottom == rect.top) {
+					prev.bottom = rect.bottom;
+					currRow.push_back(prevRow[j]);
+					prevRow.remove_at(j);
+					merged = true;
+					break;
+				}
+			}
+
+			if (!merged) {
+				rects->push_back(rect);
+				currRow.push_back(--rects->end());
+			}
 
 			++i;
 		}
+
+		prevRow.clear();
+		SWAP(prevRow, currRow);
 	}
 
 	return rects;
@@ -48,6 +48,7 @@ public:
 	RectangleList *getRectangles();
 protected:
 	BoundingBox *_tiles;
+	int16 _width, _height;
 	int16 _tilesW, _tilesH;
 	byte TileX0(const BoundingBox &boundingBox);
 	byte TileY0(const BoundingBox &boundingBox);
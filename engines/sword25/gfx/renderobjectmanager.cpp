@@ -58,12 +58,13 @@ bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueIte
 }
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
-	_frameStarted(false) {
+	_frameStarted(false), _lastDirtyArea(0), _lastDirtyRectCount(0) {
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
 	_uta = new MicroTileArray(width, height);
 	_currQueue = new RenderObjectQueue();
 	_prevQueue = new RenderObjectQueue();
+	resetStatistics();
 }
 
 RenderObjectManager::~RenderObjectManager() {
@@ -115,6 +116,25 @@ bool RenderObjectManager::render() {
 	}
 
 	RectangleList *updateRects = _uta->getRectangles();
+
+	_lastDirtyArea = 0;
+	_lastDirtyRectCount = updateRects->size();
+	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt)
+		_lastDirtyArea += (*rectIt).width() * (*rectIt).height();
+
+	_stats.frames++;
+	_stats.dirtyRects += _lastDirtyRectCount;
+	_stats.dirtyArea += _lastDirtyArea;
+
+	// Nothing has changed, so neither the back surface nor the screen need
+	// to be touched
+	if (updateRects->empty()) {
+		_stats.skippedFrames++;
+		delete updateRects;
+		SWAP(_currQueue, _prevQueue);
+		return true;
+	}
+
 	Common::Array<int> updateRectsMinZ;
 
 	updateRectsMinZ.reserve(updateRects->size());
@@ -135,7 +155,7 @@ bool RenderObjectManager::render() {
 	}
 
 	if (_rootPtr->render(updateRects, updateRectsMinZ)) {
-		// Copy updated rectangles to the video screen
+		// Copy only the updated rectangles to the video screen
 		Graphics::Surface *backSurface = Kernel::getInstance()->getGfx()->getSurface();
 		for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
 			const int x = (*rectIt).left;
@@ -153,6 +173,13 @@ bool RenderObjectManager::render() {
 	return true;
 }
 
+void RenderObjectManager::resetStatistics() {
+	_stats.frames = 0;
+	_stats.skippedFrames = 0;
+	_stats.dirtyRects = 0;
+	_stats.dirtyArea = 0;
+}
+
 void RenderObjectManager::attatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> renderObjectPtr) {
 	_timedRenderObjects.push_back(renderObjectPtr);
 }
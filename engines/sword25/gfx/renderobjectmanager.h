@@ -78,6 +78,13 @@ public:
 */
 class RenderObjectManager : public Persistable {
 public:
+	struct RenderStatistics {
+		uint32 frames;        ///< number of frames rendered
+		uint32 skippedFrames; ///< number of frames in which nothing had changed
+		uint32 dirtyRects;    ///< number of rectangles copied to the screen
+		uint64 dirtyArea;     ///< number of pixels copied to the screen
+	};
+
 	/**
 	    @brief Erzeugt ein neues BS_RenderObjectManager-Objekt.
 	    @param Width die horizontale Bildschirmauflsung in Pixeln
@@ -123,11 +130,26 @@ public:
 	*/
 	void detatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> pRenderObject);
 
+	/**
+	 * Returns the number of pixels copied to the screen by the last call of render().
+	 */
+	uint getLastDirtyArea() const { return _lastDirtyArea; }
+	/**
+	 * Returns the number of rectangles copied to the screen by the last call of render().
+	 */
+	uint getLastDirtyRectCount() const { return _lastDirtyRectCount; }
+
+	const RenderStatistics &getStatistics() const { return _stats; }
+	void resetStatistics();
+
 	virtual bool persist(OutputPersistenceBlock &writer);
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
 private:
 	bool _frameStarted;
+	uint _lastDirtyArea;
+	uint _lastDirtyRectCount;
+	RenderStatistics _stats;
 	typedef Common::Array<RenderObjectPtr<TimedRenderObject> > RenderObjectList;
 	RenderObjectList _timedRenderObjects;
 
@@ -29,21 +29,22 @@
  *
  */
 
+#include "common/endian.h"
 #include "common/textconsole.h"
 
 #include "sword25/kernel/inputpersistenceblock.h"
 
 namespace Sword25 {
 
-InputPersistenceBlock::InputPersistenceBlock(const void *data, uint dataLength, int version) :
-	_data(static_cast<const byte *>(data), dataLength),
+InputPersistenceBlock::InputPersistenceBlock(Common::ReadStream *stream, uint dataLength, int version) :
+	_stream(stream),
+	_remaining(dataLength),
 	_errorState(NONE),
 	_version(version) {
-	_iter = _data.begin();
 }
 
 InputPersistenceBlock::~InputPersistenceBlock() {
-	if (_iter != _data.end())
+	if (_remaining != 0)
 		warning("Persistence block was not read to the end.");
 }
 
@@ -55,8 +56,7 @@ void InputPersistenceBlock::read(int16 &value) {
 
 void InputPersistenceBlock::read(int32 &value) {
 	if (checkMarker(SINT_MARKER)) {
-		value = (int32)READ_LE_UINT32(_iter);
-		_iter += 4;
+		value = (int32)readUint32();
 	} else {
 		value = 0;
 	}
@@ -64,8 +64,7 @@ void InputPersistenceBlock::read(int32 &value) {
 
 void InputPersistenceBlock::read(uint32 &value) {
 	if (checkMarker(UINT_MARKER)) {
-		value = READ_LE_UINT32(_iter);
-		_iter += 4;
+		value = readUint32();
 	} else {
 		value = 0;
 	}
@@ -74,9 +73,8 @@ void InputPersistenceBlock::read(uint32 &value) {
 void InputPersistenceBlock::read(float &value) {
 	if (checkMarker(FLOAT_MARKER)) {
 		uint32 tmp[1];
-		tmp[0] = READ_LE_UINT32(_iter);
+		tmp[0] = readUint32();
 		value = ((float *)tmp)[0];
-		_iter += 4;
 	} else {
 		value = 0.0f;
 	}
@@ -84,8 +82,7 @@ void InputPersistenceBlock::read(float &value) {
 
 void InputPersistenceBlock::read(bool &value) {
 	if (checkMarker(BOOL_MARKER)) {
-		uint uintBool = READ_LE_UINT32(_iter);
-		_iter += 4;
+		uint uintBool = readUint32();
 		value = uintBool != 0;
 	} else {
 		value = false;
@@ -99,27 +96,61 @@ void InputPersistenceBlock::readString(Common::String &value) {
 		uint32 size;
 		read(size);
 
-		if (checkBlockSize(size)) {
-			value = Common::String(reinterpret_cast<const char *>(&*_iter), size);
-			_iter += size;
+		if (size > 0 && checkBlockSize(size)) {
+			char *buffer = new char[size];
+			readRaw(buffer, size);
+			value = Common::String(buffer, size);
+			delete[] buffer;
 		}
 	}
 }
 
 void InputPersistenceBlock::readByteArray(Common::Array<byte> &value) {
+	uint32 size = readByteArraySize();
+
+	value.resize(size);
+	if (size > 0)
+		readRaw(&value[0], size);
+}
+
+uint32 InputPersistenceBlock::readByteArraySize() {
 	if (checkMarker(BLOCK_MARKER)) {
 		uint32 size;
 		read(size);
 
-		if (checkBlockSize(size)) {
-			value = Common::Array<byte>(_iter, size);
-			_iter += size;
-		}
+		if (checkBlockSize(size))
+			return size;
 	}
+
+	return 0;
+}
+
+uint32 InputPersistenceBlock::readRaw(void *data, uint32 size) {
+	if (!isGood() || !checkBlockSize(size))
+		return 0;
+
+	uint32 bytesRead = _stream->read(data, size);
+	_remaining -= bytesRead;
+
+	if (bytesRead != size) {
+		_errorState = END_OF_DATA;
+		error("Unexpected end of persistence block.");
+	}
+
+	return bytesRead;
+}
+
+uint32 InputPersistenceBlock::readUint32() {
+	byte buffer[4];
+
+	if (readRaw(buffer, 4) != 4)
+		return 0;
+
+	return READ_LE_UINT32(buffer);
 }
 
-bool InputPersistenceBlock::checkBlockSize(int size) {
-	if (_data.end() - _iter >= size) {
+bool InputPersistenceBlock::checkBlockSize(uint size) {
+	if (_remaining >= size) {
 		return true;
 	} else {
 		_errorState = END_OF_DATA;
@@ -129,10 +160,11 @@ bool InputPersistenceBlock::checkBlockSize(int size) {
 }
 
 bool InputPersistenceBlock::checkMarker(byte marker) {
-	if (!isGood() || !checkBlockSize(1))
+	byte value;
+	if (!isGood() || readRaw(&value, 1) != 1)
 		return false;
 
-	if (*_iter++ == marker) {
+	if (value == marker) {
 		return true;
 	} else {
 		_errorState = OUT_OF_SYNC;
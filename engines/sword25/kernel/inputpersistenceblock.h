@@ -33,6 +33,7 @@
 #define SWORD25_INPUTPERSISTENCEBLOCK_H
 
 #include "common/array.h"
+#include "common/stream.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
@@ -46,7 +47,12 @@ public:
 		OUT_OF_SYNC
 	};
 
-	InputPersistenceBlock(const void *data, uint dataLength, int version);
+	/**
+	 * Read a persistence block of dataLength bytes from the given stream.
+	 * The data is read as it is needed, the stream has to stay valid for
+	 * the lifetime of the block.
+	 */
+	InputPersistenceBlock(Common::ReadStream *stream, uint dataLength, int version);
 	virtual ~InputPersistenceBlock();
 
 	void read(int16 &value);
@@ -57,6 +63,13 @@ public:
 	void readString(Common::String &value);
 	void readByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Read the size of a byte array. Its contents then have to be read
+	 * with readRaw(), which allows reading them in pieces.
+	 */
+	uint32 readByteArraySize();
+	uint32 readRaw(void *data, uint32 size);
+
 	bool isGood() const {
 		return _errorState == NONE;
 	}
@@ -68,10 +81,11 @@ public:
 
 private:
 	bool checkMarker(byte marker);
-	bool checkBlockSize(int size);
+	bool checkBlockSize(uint size);
+	uint32 readUint32();
 
-	Common::Array<byte> _data;
-	Common::Array<byte>::const_iterator _iter;
+	Common::ReadStream *_stream;
+	uint _remaining;
 	ErrorState _errorState;
 
 	int _version;
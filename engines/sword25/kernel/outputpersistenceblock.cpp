@@ -85,6 +85,22 @@ void OutputPersistenceBlock::writeByteArray(Common::Array<byte> &value) {
 	rawWrite(&value[0], value.size());
 }
 
+uint OutputPersistenceBlock::beginByteArray() {
+	writeMarker(BLOCK_MARKER);
+
+	// Same layout as write(uint32), the size is filled in by endByteArray()
+	writeMarker(UINT_MARKER);
+	uint start = _data.size();
+	uint32 size = 0;
+	rawWrite(&size, sizeof(size));
+
+	return start;
+}
+
+void OutputPersistenceBlock::endByteArray(uint start) {
+	WRITE_LE_UINT32(&_data[start], _data.size() - start - sizeof(uint32));
+}
+
 void OutputPersistenceBlock::writeMarker(byte marker) {
 	_data.push_back(marker);
 }
@@ -92,6 +108,14 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+
+		// Array::resize() only allocates as much as needed, so grow the
+		// buffer in powers of two to keep appending cheap
+		uint capacity = INITIAL_BUFFER_SIZE;
+		while (capacity < oldSize + size)
+			capacity *= 2;
+		_data.reserve(capacity);
+
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
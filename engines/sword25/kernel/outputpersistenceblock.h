@@ -48,6 +48,18 @@ public:
 	void writeString(const Common::String &string);
 	void writeByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Start a byte array of yet unknown size. Its contents are added with
+	 * appendToByteArray(), endByteArray() then fills in the size. This
+	 * avoids collecting the contents in a separate array first.
+	 * @return	the position to pass to endByteArray()
+	 */
+	uint beginByteArray();
+	void appendToByteArray(const void *data, uint size) {
+		rawWrite(data, size);
+	}
+	void endByteArray(uint start);
+
 	const void *getData() const {
 		return &_data[0];
 	}
@@ -31,6 +31,7 @@
 
 #include "common/fs.h"
 #include "common/savefile.h"
+#include "common/substream.h"
 #include "common/zlib.h"
 #include "sword25/kernel/kernel.h"
 #include "sword25/kernel/persistenceservice.h"
@@ -373,51 +374,45 @@ bool PersistenceService::loadGame(uint slotID) {
 	}
 #endif
 
-	byte *compressedDataBuffer = new byte[curSavegameInfo.gamedataLength];
-	byte *uncompressedDataBuffer = new byte[curSavegameInfo.gamedataUncompressedLength];
 	Common::String filename = generateSavegameFilename(slotID);
 	file = sfm->openForLoading(filename);
-
-	file->seek(curSavegameInfo.gamedataOffset);
-	file->read(reinterpret_cast<char *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength);
-	if (file->err()) {
-		error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
-		delete[] compressedDataBuffer;
-		delete[] uncompressedDataBuffer;
+	if (!file) {
+		error("Unable to open the savegame file \"%s\".", filename.c_str());
 		return false;
 	}
 
-	// Uncompress game data, if needed.
-	unsigned long uncompressedBufferSize = curSavegameInfo.gamedataUncompressedLength;
+	// The game data is read from the file as it is unpersisted, instead of
+	// loading it into memory as a whole first.
+	uint32 gamedataEnd = curSavegameInfo.gamedataOffset + curSavegameInfo.gamedataLength;
+	Common::SeekableReadStream *gamedata = new Common::SeekableSubReadStream(file, curSavegameInfo.gamedataOffset, gamedataEnd);
 
-	if (uncompressedBufferSize > curSavegameInfo.gamedataLength) {
+	if (curSavegameInfo.gamedataUncompressedLength > curSavegameInfo.gamedataLength) {
 		// Older saved game, where the game data was compressed again.
-		if (!Common::uncompress(reinterpret_cast<byte *>(&uncompressedDataBuffer[0]), &uncompressedBufferSize,
-					   reinterpret_cast<byte *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength)) {
+		gamedata = Common::wrapCompressedReadStream(gamedata, curSavegameInfo.gamedataUncompressedLength);
+		if (!gamedata) {
 			error("Unable to decompress the gamedata from savegame file \"%s\".", filename.c_str());
-			delete[] uncompressedDataBuffer;
-			delete[] compressedDataBuffer;
 			delete file;
 			return false;
 		}
-	} else {
-		// Newer saved game with uncompressed game data, copy it as-is.
-		memcpy(uncompressedDataBuffer, compressedDataBuffer, uncompressedBufferSize);
 	}
 
-	InputPersistenceBlock reader(&uncompressedDataBuffer[0], curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
-
-	// Einzelne Engine-Module depersistieren.
 	bool success = true;
-	success &= Kernel::getInstance()->getScript()->unpersist(reader);
-	// Muss unbedingt nach Script passieren. Da sonst die bereits wiederhergestellten Regions per Garbage-Collection gekillt werden.
-	success &= RegionRegistry::instance().unpersist(reader);
-	success &= Kernel::getInstance()->getGfx()->unpersist(reader);
-	success &= Kernel::getInstance()->getSfx()->unpersist(reader);
-	success &= Kernel::getInstance()->getInput()->unpersist(reader);
-
-	delete[] compressedDataBuffer;
-	delete[] uncompressedDataBuffer;
+	{
+		InputPersistenceBlock reader(gamedata, curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
+
+		// Einzelne Engine-Module depersistieren.
+		success &= Kernel::getInstance()->getScript()->unpersist(reader);
+		// Muss unbedingt nach Script passieren. Da sonst die bereits wiederhergestellten Regions per Garbage-Collection gekillt werden.
+		success &= RegionRegistry::instance().unpersist(reader);
+		success &= Kernel::getInstance()->getGfx()->unpersist(reader);
+		success &= Kernel::getInstance()->getSfx()->unpersist(reader);
+		success &= Kernel::getInstance()->getInput()->unpersist(reader);
+	}
+
+	if (gamedata->err())
+		success = false;
+
+	delete gamedata;
 	delete file;
 
 	if (!success) {
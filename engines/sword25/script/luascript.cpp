@@ -31,6 +31,7 @@
 
 #include "common/array.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sword25/sword25.h"
 #include "sword25/package/packagemanager.h"
@@ -43,6 +44,8 @@
 #include "sword25/util/lua/lua.h"
 #include "sword25/util/lua/lualib.h"
 #include "sword25/util/lua/lauxlib.h"
+#include "sword25/util/lua/lgc.h"
+#include "sword25/util/lua/lstate.h"
 #include "sword25/util/pluto/pluto.h"
 
 namespace Sword25 {
@@ -50,7 +53,11 @@ namespace Sword25 {
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
-	_pcallErrorhandlerRegistryIndex(0) {
+	_pcallErrorhandlerRegistryIndex(0),
+	_gcPause(LUAI_GCPAUSE),
+	_gcStepMultiplier(LUAI_GCMUL),
+	_gcFrameBudget(1) {
+	resetGCStatistics();
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
@@ -130,6 +137,9 @@ bool LuaScriptEngine::init() {
 			lua_sethook(_state, debugHook, mask, 0);
 	}
 
+	lua_gc(_state, LUA_GCSETPAUSE, _gcPause);
+	lua_gc(_state, LUA_GCSETSTEPMUL, _gcStepMultiplier);
+
 	debugC(kDebugScript, "Lua initialized.");
 
 	return true;
@@ -387,11 +397,8 @@ bool pushPermanentsTable(lua_State *L, PERMANENT_TABLE_TYPE tableType) {
 
 namespace {
 int chunkwriter(lua_State *L, const void *p, size_t sz, void *ud) {
-	Common::Array<byte> & chunkData = *reinterpret_cast<Common::Array<byte> * >(ud);
-	const byte *buffer = reinterpret_cast<const byte *>(p);
-
-	while (sz--)
-		chunkData.push_back(*buffer++);
+	OutputPersistenceBlock &writer = *reinterpret_cast<OutputPersistenceBlock *>(ud);
+	writer.appendToByteArray(p, sz);
 
 	return 1;
 }
@@ -402,19 +409,17 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	lua_settop(_state, 0);
 
 	// Garbage Collection erzwingen.
-	lua_gc(_state, LUA_GCCOLLECT, 0);
+	collectGarbage();
 
 	// Permanents-Table is set on the stack
 	// pluto_persist expects these two items on the Lua stack
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a Common::Array
-	Common::Array<byte> chunkData;
-	pluto_persist(_state, chunkwriter, &chunkData);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.writeByteArray(chunkData);
+	// Lua persists and stores the data directly in the writer
+	uint chunkStart = writer.beginByteArray();
+	pluto_persist(_state, chunkwriter, &writer);
+	writer.endByteArray(chunkStart);
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
@@ -424,22 +429,27 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 
 namespace {
 
+const uint CHUNK_BUFFER_SIZE = 64 * 1024;
+
 struct ChunkreaderData {
-	void   *BufferPtr;
-	size_t  Size;
-	bool    BufferReturned;
+	InputPersistenceBlock *Reader;
+	uint32 Remaining;
+	byte   *Buffer;
 };
 
 const char *chunkreader(lua_State *L, void *ud, size_t *sz) {
 	ChunkreaderData &cd = *reinterpret_cast<ChunkreaderData *>(ud);
 
-	if (!cd.BufferReturned) {
-		cd.BufferReturned = true;
-		*sz = cd.Size;
-		return reinterpret_cast<const char *>(cd.BufferPtr);
-	} else {
+	// Hand the persisted data to Lua piece by piece
+	uint32 size = MIN<uint32>(cd.Remaining, CHUNK_BUFFER_SIZE);
+	if (size == 0)
 		return 0;
-	}
+
+	size = cd.Reader->readRaw(cd.Buffer, size);
+	cd.Remaining -= size;
+	*sz = size;
+
+	return size ? reinterpret_cast<const char *>(cd.Buffer) : 0;
 }
 
 void clearGlobalTable(lua_State *L, const char **exceptions) {
@@ -509,18 +519,22 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	};
 	clearGlobalTable(_state, clearExceptionsSecondPass);
 
-	// Persisted Lua data
-	Common::Array<byte> chunkData;
-	reader.readByteArray(chunkData);
-
-	// Chunk-Reader initialisation. It is used with pluto_unpersist to restore read data
+	// Chunk-Reader initialisation. It is used with pluto_unpersist to restore
+	// read data, which is read from the persistence block as it is needed
 	ChunkreaderData cd;
-	cd.BufferPtr = &chunkData[0];
-	cd.Size = chunkData.size();
-	cd.BufferReturned = false;
+	cd.Reader = &reader;
+	cd.Remaining = reader.readByteArraySize();
+	cd.Buffer = new byte[CHUNK_BUFFER_SIZE];
 
 	pluto_unpersist(_state, chunkreader, &cd);
 
+	// Skip whatever Lua did not read, so that the next module starts at the right position
+	size_t skipped;
+	while (chunkreader(_state, &cd, &skipped))
+		;
+
+	delete[] cd.Buffer;
+
 	// Permanents-Table is removed from stack
 	lua_remove(_state, -2);
 
@@ -544,9 +558,66 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	lua_pop(_state, 1);
 
 	// Force garbage collection
-	lua_gc(_state, LUA_GCCOLLECT, 0);
+	collectGarbage();
 
 	return true;
 }
 
+void LuaScriptEngine::collectGarbage() {
+	uint32 startTime = g_system->getMillis();
+	lua_gc(_state, LUA_GCCOLLECT, 0);
+
+	_gcStats.fullCollections++;
+	_gcStats.fullTime += g_system->getMillis() - startTime;
+}
+
+void LuaScriptEngine::endFrame() {
+	if (!_state || _gcFrameBudget == 0)
+		return;
+
+	// A step always starts a new cycle if the collector is idle. Leave it
+	// idle until its threshold is reached, so that the pause between
+	// cycles is kept.
+	global_State *g = G(_state);
+	if (g->gcstate == GCSpause && g->totalbytes < g->GCthreshold)
+		return;
+
+	// Do the collector's work while the frame is shown, instead of in
+	// the middle of the next one. Stop when a cycle is finished.
+	uint32 startTime = g_system->getMillis();
+	uint32 elapsed = 0;
+	do {
+		_gcStats.frameSteps++;
+		if (lua_gc(_state, LUA_GCSTEP, 0)) {
+			_gcStats.frameCycles++;
+			elapsed = g_system->getMillis() - startTime;
+			break;
+		}
+		elapsed = g_system->getMillis() - startTime;
+	} while (elapsed < _gcFrameBudget);
+
+	_gcStats.frameTime += elapsed;
+	_gcStats.maxFrameTime = MAX(_gcStats.maxFrameTime, elapsed);
+}
+
+void LuaScriptEngine::setGCPause(int pause) {
+	_gcPause = pause;
+	if (_state)
+		lua_gc(_state, LUA_GCSETPAUSE, pause);
+}
+
+void LuaScriptEngine::setGCStepMultiplier(int stepMultiplier) {
+	_gcStepMultiplier = stepMultiplier;
+	if (_state)
+		lua_gc(_state, LUA_GCSETSTEPMUL, stepMultiplier);
+}
+
+uint LuaScriptEngine::getMemoryUsage() const {
+	return _state ? lua_gc(_state, LUA_GCCOUNT, 0) : 0;
+}
+
+void LuaScriptEngine::resetGCStatistics() {
+	memset(&_gcStats, 0, sizeof(_gcStats));
+}
+
 } // End of namespace Sword25
@@ -93,10 +93,61 @@ public:
 	 */
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
+	/**
+	 * Runs incremental garbage collection steps for at most the frame
+	 * budget set with setGCFrameBudget().
+	 */
+	virtual void endFrame();
+
+	struct GCStatistics {
+		uint32 frameSteps;      ///< number of incremental steps run at the end of frames
+		uint32 frameCycles;     ///< number of collection cycles finished by these steps
+		uint32 frameTime;       ///< time spent in these steps (in milliseconds)
+		uint32 maxFrameTime;    ///< longest time spent in these steps in one frame (in milliseconds)
+		uint32 fullCollections; ///< number of full collections, done when saving and loading
+		uint32 fullTime;        ///< time spent in full collections (in milliseconds)
+	};
+
+	/**
+	 * Sets how long the collector waits before starting a new cycle, in
+	 * percent of the memory in use after the last one (Lua default: 200).
+	 */
+	void setGCPause(int pause);
+	int getGCPause() const { return _gcPause; }
+
+	/**
+	 * Sets the speed of the collector relative to memory allocation, in
+	 * percent (Lua default: 200).
+	 */
+	void setGCStepMultiplier(int stepMultiplier);
+	int getGCStepMultiplier() const { return _gcStepMultiplier; }
+
+	/**
+	 * Sets the time (in milliseconds) to spend on garbage collection at
+	 * the end of every frame. 0 leaves collection to the allocator.
+	 */
+	void setGCFrameBudget(uint32 msecs) { _gcFrameBudget = msecs; }
+	uint32 getGCFrameBudget() const { return _gcFrameBudget; }
+
+	/**
+	 * Returns the memory used by Lua in kilobytes.
+	 */
+	uint getMemoryUsage() const;
+
+	const GCStatistics &getGCStatistics() const { return _gcStats; }
+	void resetGCStatistics();
+
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
 
+	int _gcPause;
+	int _gcStepMultiplier;
+	uint32 _gcFrameBudget;
+	GCStatistics _gcStats;
+
+	void collectGarbage();
+
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
 	bool executeBuffer(const byte *data, uint size, const Common::String &name) const;
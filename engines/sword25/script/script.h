@@ -86,6 +86,11 @@ public:
 
 	virtual bool persist(OutputPersistenceBlock &writer) = 0;
 	virtual bool unpersist(InputPersistenceBlock &reader) = 0;
+
+	/**
+	 * Called at the end of every frame, after the screen was updated.
+	 */
+	virtual void endFrame() {}
 };
 
 } // End of namespace Sword25
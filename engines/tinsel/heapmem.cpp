@@ -25,6 +25,8 @@
 #include "tinsel/timers.h"	// For DwGetCurrentTime
 #include "tinsel/tinsel.h"
 
+#include "common/config-manager.h"
+
 namespace Tinsel {
 
 
@@ -45,6 +47,8 @@ struct MEM_NODE {
 	long size;		// size of the memory object
 	uint32 lruTime;		// time when memory object was last accessed
 	int flags;		// allocation attributes
+	MEM_NODE *pLruNext;	// link to the next node in the LRU list, NULL if not in it
+	MEM_NODE *pLruPrev;	// link to the previous node in the LRU list
 };
 
 
@@ -52,6 +56,7 @@ struct MEM_NODE {
 // Currently this is set at 5MB for the DW1 demo and DW1 and 10MB for DW2
 // This could probably be reduced somewhat
 // If the memory is not enough, the engine throws an "Out of memory" error in handle.cpp inside LockMem()
+// A larger heap can be set with the "heapsize" config key (in kilobytes)
 static const uint32 MemoryPoolSize[3] = {5 * 1024 * 1024, 5 * 1024 * 1024, 10 * 1024 * 1024};
 
 // FIXME: Avoid non-const global vars
@@ -69,9 +74,37 @@ MEM_NODE g_s_fixedMnodesList[5];
 // the mnode heap sentinel
 static MEM_NODE g_heapSentinel;
 
+// sentinel of the list of discardable blocks (used, unlocked and not
+// discarded), ordered from least to most recently used
+static MEM_NODE g_lruSentinel;
+
 //
 static MEM_NODE *AllocMemNode();
 
+/**
+ * Remove a memory object from the LRU list, if it is in it.
+ */
+static void LruUnlink(MEM_NODE *pMemNode) {
+	if (pMemNode->pLruNext) {
+		pMemNode->pLruNext->pLruPrev = pMemNode->pLruPrev;
+		pMemNode->pLruPrev->pLruNext = pMemNode->pLruNext;
+		pMemNode->pLruNext = NULL;
+		pMemNode->pLruPrev = NULL;
+	}
+}
+
+/**
+ * Make a memory object the most recently used one of the LRU list.
+ */
+static void LruAppend(MEM_NODE *pMemNode) {
+	LruUnlink(pMemNode);
+
+	pMemNode->pLruPrev = g_lruSentinel.pLruPrev;
+	pMemNode->pLruNext = &g_lruSentinel;
+	g_lruSentinel.pLruPrev->pLruNext = pMemNode;
+	g_lruSentinel.pLruPrev = pMemNode;
+}
+
 #ifdef DEBUG
 static void MemoryStats() {
 	int usedNodes = 0;
@@ -125,10 +158,17 @@ void MemoryInit() {
 	// flag sentinel as locked
 	g_heapSentinel.flags = DWM_LOCKED | DWM_SENTINEL;
 
+	// the LRU list starts out empty
+	g_lruSentinel.pLruPrev = &g_lruSentinel;
+	g_lruSentinel.pLruNext = &g_lruSentinel;
+	g_lruSentinel.flags = DWM_LOCKED | DWM_SENTINEL;
+
 	// store the current heap size in the sentinel
 	uint32 size = MemoryPoolSize[0];
 	if (TinselVersion == TINSEL_V1) size = MemoryPoolSize[1];
 	else if (TinselVersion == TINSEL_V2) size = MemoryPoolSize[2];
+	if (ConfMan.hasKey("heapsize"))
+		size = MAX<uint32>(size, ConfMan.getInt("heapsize") * 1024);
 	g_heapSentinel.size = size;
 }
 
@@ -194,31 +234,20 @@ void FreeMemNode(MEM_NODE *pMemNode) {
  * @return true if any blocks were discarded, false otherwise
  */
 static bool HeapCompact(long size) {
-	const MEM_NODE *pHeap = &g_heapSentinel;
-	MEM_NODE *pCur, *pOldest;
-	uint32 oldest;		// time of the oldest discardable block
+	// blocks used during the current frame are never discarded
+	uint32 now = DwGetCurrentTime();
 
+	// discard blocks in LRU order, oldest first
+	MEM_NODE *pCur = g_lruSentinel.pLruNext;
 	while (g_heapSentinel.size < size) {
-
-		// find the oldest discardable block
-		oldest = DwGetCurrentTime();
-		pOldest = NULL;
-		for (pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
-			if (pCur->flags == DWM_USED) {
-				// found a non-discarded discardable block
-				if (pCur->lruTime < oldest) {
-					oldest = pCur->lruTime;
-					pOldest = pCur;
-				}
-			}
-		}
-
-		if (pOldest)
-			// discard the oldest block
-			MemoryDiscard(pOldest);
-		else
-			// cannot discard any blocks
+		if (pCur == &g_lruSentinel)
+			// cannot discard any more blocks
 			return false;
+
+		MEM_NODE *pNext = pCur->pLruNext;
+		if (pCur->lruTime < now)
+			MemoryDiscard(pCur);
+		pCur = pNext;
 	}
 
 	// we have freed enough memory
@@ -274,6 +303,9 @@ static MEM_NODE *MemoryAlloc(long size) {
 	pHeap->pPrev->pNext = pNode;
 	pHeap->pPrev = pNode;
 
+	// the new block is discardable until it gets locked
+	LruAppend(pNode);
+
 	return pNode;
 }
 
@@ -349,6 +381,8 @@ void MemoryDiscard(MEM_NODE *pMemNode) {
 
 	// discard it if it isn't already
 	if ((pMemNode->flags & DWM_DISCARDED) == 0) {
+		LruUnlink(pMemNode);
+
 		// free memory
 		free(pMemNode->pBaseAddr);
 		g_heapSentinel.size += pMemNode->size;
@@ -380,6 +414,9 @@ void *MemoryLock(MEM_NODE *pMemNode) {
 	// set the lock flag
 	pMemNode->flags |= DWM_LOCKED;
 
+	// locked blocks cannot be discarded
+	LruUnlink(pMemNode);
+
 #ifdef DEBUG
 	MemoryStats();
 #endif
@@ -405,6 +442,11 @@ void MemoryUnlock(MEM_NODE *pMemNode) {
 
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+
+	// the block is discardable again, unless it has been discarded already
+	// or is a fixed block
+	if (pMemNode->flags == DWM_USED && pMemNode >= g_mnodeList && pMemNode < g_mnodeList + NUM_MNODES)
+		LruAppend(pMemNode);
 }
 
 /**
@@ -446,6 +488,10 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 		pMemNode->pPrev->pNext = pMemNode;
 		pMemNode->pNext->pPrev = pMemNode;
 
+		// and into the LRU list, in place of the new node
+		pMemNode->pLruPrev->pLruNext = pMemNode;
+		pMemNode->pLruNext->pLruPrev = pMemNode;
+
 		// free the new node
 		FreeMemNode(pNew);
 	}
@@ -460,6 +506,10 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 void MemoryTouch(MEM_NODE *pMemNode) {
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+
+	// and move it to the end of the LRU list
+	if (pMemNode->pLruNext)
+		LruAppend(pMemNode);
 }
 
 uint8 *MemoryDeref(MEM_NODE *pMemNode) {
@@ -21,15 +21,36 @@
  */
 
 #include "toon/console.h"
+#include "toon/path.h"
 #include "toon/toon.h"
 
 namespace Toon {
 
 ToonConsole::ToonConsole(ToonEngine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("path_stats", WRAP_METHOD(ToonConsole, Cmd_PathStats));
 }
 
 ToonConsole::~ToonConsole() {
 }
 
+bool ToonConsole::Cmd_PathStats(int argc, const char **argv) {
+	PathFinding *pathFinding = _vm->getPathFinding();
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		pathFinding->resetStatistics();
+		debugPrintf("Path finding statistics reset\n");
+		return true;
+	}
+
+	const PathFinding::Statistics &stats = pathFinding->getStatistics();
+	debugPrintf("Searches: %d (%d unreachable, %d on the whole mask)\n", stats.searches, stats.unreachable, stats.fallbacks);
+	debugPrintf("Search time: %d ms total, %d ms average, %d ms max\n", stats.totalTime,
+		stats.searches ? stats.totalTime / stats.searches : 0, stats.maxTime);
+	debugPrintf("Coarse graph: %d pieces, built %d times\n", stats.graphPieces, stats.graphBuilds);
+	debugPrintf("Use '%s reset' to reset the statistics\n", argv[0]);
+	return true;
+}
+
 } // End of namespace Toon
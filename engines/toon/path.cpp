@@ -21,6 +21,8 @@
  */
 
 #include "common/debug.h"
+#include "common/stack.h"
+#include "common/system.h"
 
 #include "toon/path.h"
 
@@ -154,6 +156,17 @@ PathFinding::PathFinding() {
 	_numBlockingRects = 0;
 
 	_currentMask = nullptr;
+
+	_graphValid = false;
+	_sectorsX = 0;
+	_sectorsY = 0;
+	_pieceMap = NULL;
+	_sectorBlocked = NULL;
+	_sectorMark = NULL;
+	_searchId = 0;
+	_coarseHeap = new PathFindingHeap();
+
+	resetStatistics();
 }
 
 PathFinding::~PathFinding(void) {
@@ -161,6 +174,13 @@ PathFinding::~PathFinding(void) {
 		_heap->unload();
 	delete _heap;
 	delete[] _sq;
+
+	if (_coarseHeap)
+		_coarseHeap->unload();
+	delete _coarseHeap;
+	delete[] _pieceMap;
+	delete[] _sectorBlocked;
+	delete[] _sectorMark;
 }
 
 void PathFinding::init(Picture *mask) {
@@ -173,6 +193,30 @@ void PathFinding::init(Picture *mask) {
 	_heap->init(500);
 	delete[] _sq;
 	_sq = new uint16[_width * _height];
+
+	// The coarse graph is built on the first search
+	_graphValid = false;
+	_sectorsX = (_width + kSectorSize - 1) / kSectorSize;
+	_sectorsY = (_height + kSectorSize - 1) / kSectorSize;
+	delete[] _pieceMap;
+	_pieceMap = new uint16[_width * _height];
+	delete[] _sectorMark;
+	_sectorMark = new uint16[_sectorsX * _sectorsY];
+	memset(_sectorMark, 0, _sectorsX * _sectorsY * sizeof(uint16));
+	_searchId = 0;
+	_coarseHeap->unload();
+	_coarseHeap->init(100);
+
+	delete[] _sectorBlocked;
+	_sectorBlocked = new uint8[_sectorsX * _sectorsY];
+	memset(_sectorBlocked, 0, _sectorsX * _sectorsY);
+	for (uint8 i = 0; i < _numBlockingRects; i++) {
+		if (_blockingRects[i][4] == 0)
+			markBlockedSectors(_blockingRects[i][0], _blockingRects[i][1], _blockingRects[i][2], _blockingRects[i][3]);
+		else
+			markBlockedSectors(_blockingRects[i][0] - _blockingRects[i][2], _blockingRects[i][1] - _blockingRects[i][3],
+			                   _blockingRects[i][0] + _blockingRects[i][2], _blockingRects[i][1] + _blockingRects[i][3]);
+	}
 }
 
 bool PathFinding::isLikelyWalkable(int16 x, int16 y) {
@@ -306,6 +350,45 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 	}
 
 	// no direct line, we use the standard A* algorithm
+	uint32 startTime = g_system->getMillis();
+	_stats.searches++;
+
+	if (!_graphValid)
+		buildGraph();
+
+	bool searched = false;
+	bool found = false;
+	if (_graphValid && x < _width && y < _height && destx < _width && desty < _height && isWalkable(x, y)) {
+		uint16 startPiece = _pieceMap[x + y * _width] - 1;
+		uint16 destPiece = _pieceMap[destx + desty * _width];
+
+		if (!destPiece || _pieces[startPiece].component != _pieces[destPiece - 1].component) {
+			// the destination can't be reached, no need to search
+			_tempPath.clear();
+			_stats.unreachable++;
+			searched = true;
+		} else if (findCoarsePath(startPiece, destPiece - 1)) {
+			// search the sectors along the coarse path first, the whole
+			// mask only if that fails
+			found = searchPath(x, y, destx, desty, true);
+			searched = found;
+		}
+	}
+
+	if (!searched) {
+		_stats.fallbacks++;
+		found = searchPath(x, y, destx, desty, false);
+	}
+
+	uint32 time = g_system->getMillis() - startTime;
+	_stats.totalTime += time;
+	_stats.maxTime = MAX(_stats.maxTime, time);
+	debugC(1, kDebugPath, "findPath: %s after %d ms", found ? "found" : "not found", time);
+
+	return found;
+}
+
+bool PathFinding::searchPath(int16 x, int16 y, int16 destx, int16 desty, bool restricted) {
 	memset(_sq , 0, _width * _height * sizeof(uint16));
 	_heap->clear();
 	int16 curX = x;
@@ -330,7 +413,7 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 				if (px != curX || py != curY) {
 					uint16 wei = abs(px - curX) + abs(py - curY);
 
-					if (isWalkable(px, py)) { // walkable ?
+					if (isWalkable(px, py) && (!restricted || isSectorAllowed(px, py))) { // walkable ?
 						int32 curPNode = px + py * _width;
 						uint32 sum = _sq[curNode] + wei * (1 + (isLikelyWalkable(px, py) ? 5 : 0));
 						if (sum > (uint32)0xFFFF) {
@@ -428,6 +511,8 @@ void PathFinding::addBlockingRect(int16 x1, int16 y1, int16 x2, int16 y2) {
 	_blockingRects[_numBlockingRects][3] = y2;
 	_blockingRects[_numBlockingRects][4] = 0;
 	_numBlockingRects++;
+
+	markBlockedSectors(x1, y1, x2, y2);
 }
 
 void PathFinding::addBlockingEllipse(int16 x1, int16 y1, int16 w, int16 h) {
@@ -443,6 +528,229 @@ void PathFinding::addBlockingEllipse(int16 x1, int16 y1, int16 w, int16 h) {
 	_blockingRects[_numBlockingRects][3] = h;
 	_blockingRects[_numBlockingRects][4] = 1;
 	_numBlockingRects++;
+
+	markBlockedSectors(x1 - w, y1 - h, x1 + w, y1 + h);
+}
+
+void PathFinding::resetBlockingRects() {
+	_numBlockingRects = 0;
+	if (_sectorBlocked)
+		memset(_sectorBlocked, 0, _sectorsX * _sectorsY);
+}
+
+void PathFinding::markBlockedSectors(int16 x1, int16 y1, int16 x2, int16 y2) {
+	if (!_sectorBlocked)
+		return;
+
+	// Only the sectors touched by the new rect change, the graph itself
+	// stays as it is
+	int16 startX = MAX<int16>(x1, 0) / kSectorSize;
+	int16 startY = MAX<int16>(y1, 0) / kSectorSize;
+	int16 endX = MIN<int16>(x2 / kSectorSize, _sectorsX - 1);
+	int16 endY = MIN<int16>(y2 / kSectorSize, _sectorsY - 1);
+
+	for (int16 sy = startY; sy <= endY; sy++) {
+		for (int16 sx = startX; sx <= endX; sx++) {
+			uint8 &blocked = _sectorBlocked[sy * _sectorsX + sx];
+			if (blocked < 0xFF)
+				blocked++;
+		}
+	}
+}
+
+void PathFinding::buildGraph() {
+	debugC(1, kDebugPath, "buildGraph()");
+
+	_stats.graphBuilds++;
+	_pieces.clear();
+	memset(_pieceMap, 0, _width * _height * sizeof(uint16));
+	_graphValid = true;
+
+	const uint8 *data = _currentMask->getDataPtr();
+
+	// Split each sector into its connected walkable pieces
+	for (int16 sy = 0; sy < _sectorsY; sy++) {
+		for (int16 sx = 0; sx < _sectorsX; sx++) {
+			int16 endX = MIN<int16>((sx + 1) * kSectorSize, _width);
+			int16 endY = MIN<int16>((sy + 1) * kSectorSize, _height);
+
+			for (int16 y = sy * kSectorSize; y < endY; y++) {
+				for (int16 x = sx * kSectorSize; x < endX; x++) {
+					int32 node = x + y * _width;
+					if (_pieceMap[node] || !(data[node] & 0x1f))
+						continue;
+
+					// Piece indices are pushed on the heap as int16
+					if (_pieces.size() >= 0x7FFF) {
+						warning("PathFinding: Too many pieces in the walk mask, not using the coarse graph");
+						_graphValid = false;
+						_pieces.clear();
+						return;
+					}
+
+					Piece piece;
+					piece.sector = sy * _sectorsX + sx;
+					piece.component = 0;
+					_pieces.push_back(piece);
+					floodFillPiece(x, y, _pieces.size() - 1);
+				}
+			}
+		}
+	}
+
+	// Link the pieces touching each other. Neighboring pixels of the same
+	// sector always belong to the same piece.
+	for (int16 y = 0; y < _height; y++) {
+		for (int16 x = 0; x < _width; x++) {
+			uint16 piece = _pieceMap[x + y * _width];
+			if (!piece)
+				continue;
+
+			if (x + 1 < _width && _pieceMap[x + 1 + y * _width] && _pieceMap[x + 1 + y * _width] != piece)
+				addLink(piece - 1, _pieceMap[x + 1 + y * _width] - 1);
+			if (y + 1 < _height) {
+				for (int16 px = MAX<int16>(x - 1, 0); px <= MIN<int16>(x + 1, _width - 1); px++) {
+					uint16 other = _pieceMap[px + (y + 1) * _width];
+					if (other && other != piece)
+						addLink(piece - 1, other - 1);
+				}
+			}
+		}
+	}
+
+	// Find the connected components
+	Common::Stack<uint16> stack;
+	uint16 numComponents = 0;
+	for (uint32 i = 0; i < _pieces.size(); i++) {
+		if (_pieces[i].component)
+			continue;
+
+		numComponents++;
+		_pieces[i].component = numComponents;
+		stack.push(i);
+		while (!stack.empty()) {
+			const Piece &piece = _pieces[stack.pop()];
+			for (uint32 j = 0; j < piece.links.size(); j++) {
+				Piece &other = _pieces[piece.links[j]];
+				if (!other.component) {
+					other.component = numComponents;
+					stack.push(piece.links[j]);
+				}
+			}
+		}
+	}
+
+	_stats.graphPieces = _pieces.size();
+	debugC(1, kDebugPath, "buildGraph: %d pieces in %d components", _pieces.size(), numComponents);
+}
+
+void PathFinding::floodFillPiece(int16 x, int16 y, uint16 piece) {
+	const uint8 *data = _currentMask->getDataPtr();
+	int16 startX = (x / kSectorSize) * kSectorSize;
+	int16 startY = (y / kSectorSize) * kSectorSize;
+	int16 endX = MIN<int16>(startX + kSectorSize, _width) - 1;
+	int16 endY = MIN<int16>(startY + kSectorSize, _height) - 1;
+
+	int32 sumX = 0;
+	int32 sumY = 0;
+	int32 count = 0;
+
+	Common::Stack<Common::Point> stack;
+	_pieceMap[x + y * _width] = piece + 1;
+	stack.push(Common::Point(x, y));
+	while (!stack.empty()) {
+		Common::Point pt = stack.pop();
+		sumX += pt.x;
+		sumY += pt.y;
+		count++;
+
+		for (int16 py = MAX<int16>(pt.y - 1, startY); py <= MIN<int16>(pt.y + 1, endY); py++) {
+			for (int16 px = MAX<int16>(pt.x - 1, startX); px <= MIN<int16>(pt.x + 1, endX); px++) {
+				int32 node = px + py * _width;
+				if (!_pieceMap[node] && (data[node] & 0x1f)) {
+					_pieceMap[node] = piece + 1;
+					stack.push(Common::Point(px, py));
+				}
+			}
+		}
+	}
+
+	_pieces[piece].x = sumX / count;
+	_pieces[piece].y = sumY / count;
+}
+
+void PathFinding::addLink(uint16 piece1, uint16 piece2) {
+	Common::Array<uint16> &links = _pieces[piece1].links;
+	for (uint32 i = 0; i < links.size(); i++) {
+		if (links[i] == piece2)
+			return;
+	}
+
+	links.push_back(piece2);
+	_pieces[piece2].links.push_back(piece1);
+}
+
+bool PathFinding::findCoarsePath(uint16 start, uint16 dest) {
+	_coarseCost.resize(_pieces.size());
+	_coarseParent.resize(_pieces.size());
+	for (uint32 i = 0; i < _pieces.size(); i++) {
+		_coarseCost[i] = 0xFFFFFFFF;
+		_coarseParent[i] = -1;
+	}
+
+	// A* on the pieces, with the same weights as the search on the pixels.
+	// The costs are scaled down to fit into the heap.
+	const Piece &destPiece = _pieces[dest];
+	_coarseHeap->clear();
+	_coarseCost[start] = 0;
+	_coarseHeap->push(start, 0, 0);
+
+	while (_coarseHeap->getCount()) {
+		int16 cur, unused;
+		uint16 weight;
+		_coarseHeap->pop(&cur, &unused, &weight);
+		if (cur == dest)
+			break;
+
+		const Piece &piece = _pieces[cur];
+		for (uint32 i = 0; i < piece.links.size(); i++) {
+			uint16 next = piece.links[i];
+			const Piece &nextPiece = _pieces[next];
+			uint32 wei = abs(nextPiece.x - piece.x) + abs(nextPiece.y - piece.y);
+			uint32 cost = _coarseCost[cur] + wei * (1 + (_sectorBlocked[nextPiece.sector] ? 0 : 5));
+			if (cost < _coarseCost[next]) {
+				_coarseCost[next] = cost;
+				_coarseParent[next] = cur;
+				uint32 newWeight = (cost + abs(destPiece.x - nextPiece.x) + abs(destPiece.y - nextPiece.y)) >> 2;
+				_coarseHeap->push(next, 0, MIN<uint32>(newWeight, 0xFFFF));
+			}
+		}
+	}
+
+	if (_coarseParent[dest] < 0 && start != dest)
+		return false;
+
+	// Allow the sectors along the path and their neighbors
+	if (++_searchId == 0) {
+		memset(_sectorMark, 0, _sectorsX * _sectorsY * sizeof(uint16));
+		_searchId = 1;
+	}
+
+	for (int32 cur = dest; cur >= 0; cur = _coarseParent[cur]) {
+		int16 sx = _pieces[cur].sector % _sectorsX;
+		int16 sy = _pieces[cur].sector / _sectorsX;
+		for (int16 y = MAX<int16>(sy - 1, 0); y <= MIN<int16>(sy + 1, _sectorsY - 1); y++) {
+			for (int16 x = MAX<int16>(sx - 1, 0); x <= MIN<int16>(sx + 1, _sectorsX - 1); x++)
+				_sectorMark[y * _sectorsX + x] = _searchId;
+		}
+	}
+
+	return true;
+}
+
+void PathFinding::resetStatistics() {
+	memset(&_stats, 0, sizeof(_stats));
+	_stats.graphPieces = _pieces.size();
 }
 
 } // End of namespace Toon
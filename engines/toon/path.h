@@ -55,6 +55,17 @@ private:
 	uint32 _count;
 };
 
+/**
+ * Path finding on the walk mask of a scene.
+ *
+ * Paths are searched with A* on the pixels of the mask. To keep long
+ * searches short, the mask is also split into sectors of kSectorSize
+ * pixels. The connected walkable areas of each sector (pieces) and the
+ * pieces they touch form a coarse graph, which is built when the mask
+ * is set or modified. It is used to find out right away if there is no
+ * path at all, and to restrict the pixel search to the sectors along the
+ * path found in the coarse graph.
+ */
 class PathFinding {
 public:
 	PathFinding();
@@ -69,7 +80,7 @@ public:
 	bool lineIsWalkable(int16 x, int16 y, int16 x2, int16 y2);
 	void walkLine(int16 x, int16 y, int16 x2, int16 y2);
 
-	void resetBlockingRects() { _numBlockingRects = 0; }
+	void resetBlockingRects();
 	void addBlockingRect(int16 x1, int16 y1, int16 x2, int16 y2);
 	void addBlockingEllipse(int16 x1, int16 y1, int16 w, int16 h);
 
@@ -77,8 +88,46 @@ public:
 	int16 getPathNodeX(uint32 nodeId) const { return _tempPath[(_tempPath.size() - 1) - nodeId].x; }
 	int16 getPathNodeY(uint32 nodeId) const { return _tempPath[(_tempPath.size() - 1) - nodeId].y; }
 
+	/**
+	 * Rebuild the coarse graph before the next search. This has to be
+	 * called whenever the walk mask is modified.
+	 */
+	void invalidateMask() { _graphValid = false; }
+
+	struct Statistics {
+		uint32 searches;      ///< number of searches which did not find a direct line
+		uint32 unreachable;   ///< searches answered by the coarse graph alone
+		uint32 fallbacks;     ///< searches which had to search the whole mask
+		uint32 totalTime;     ///< time spent in these searches (in milliseconds)
+		uint32 maxTime;       ///< longest search (in milliseconds)
+		uint32 graphBuilds;   ///< number of times the coarse graph was built
+		uint32 graphPieces;   ///< number of pieces in the current coarse graph
+	};
+
+	const Statistics &getStatistics() const { return _stats; }
+	void resetStatistics();
+
 private:
 	static const uint8 kMaxBlockingRects = 16;
+	static const int16 kSectorSize = 16;
+
+	struct Piece {
+		int16 x, y;       ///< center of the piece, used to estimate distances
+		uint16 sector;
+		uint16 component; ///< pieces of the same component are connected
+		Common::Array<uint16> links;
+	};
+
+	bool searchPath(int16 x, int16 y, int16 destx, int16 desty, bool restricted);
+	bool isSectorAllowed(int16 x, int16 y) const {
+		return _sectorMark[(y / kSectorSize) * _sectorsX + x / kSectorSize] == _searchId;
+	}
+
+	void buildGraph();
+	void floodFillPiece(int16 x, int16 y, uint16 piece);
+	void addLink(uint16 piece1, uint16 piece2);
+	bool findCoarsePath(uint16 start, uint16 dest);
+	void markBlockedSectors(int16 x1, int16 y1, int16 x2, int16 y2);
 
 	Picture *_currentMask;
 
@@ -92,6 +141,20 @@ private:
 
 	int16 _blockingRects[kMaxBlockingRects][5];
 	uint8 _numBlockingRects;
+
+	bool _graphValid;
+	int16 _sectorsX;
+	int16 _sectorsY;
+	uint16 *_pieceMap;                 ///< piece index + 1 of every pixel, 0 if not walkable
+	Common::Array<Piece> _pieces;
+	uint8 *_sectorBlocked;             ///< number of blocking rects overlapping each sector
+	uint16 *_sectorMark;               ///< sectors in the coarse path are marked with _searchId
+	uint16 _searchId;
+	PathFindingHeap *_coarseHeap;
+	Common::Array<uint32> _coarseCost;
+	Common::Array<int16> _coarseParent;
+
+	Statistics _stats;
 };
 
 } // End of namespace Toon
@@ -21,6 +21,7 @@
  */
 
 #include "toon/resource.h"
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/memstream.h"
@@ -29,17 +30,14 @@
 
 namespace Toon {
 
-Resources::Resources(ToonEngine *vm) : _vm(vm), _cacheSize(0) {
-	_resourceCache.clear();
+Resources::Resources(ToonEngine *vm) : _vm(vm), _resourceCache(MAX_CACHE_SIZE, freeCacheEntry) {
+	if (ConfMan.hasKey("resource_cache_size"))
+		_resourceCache.setBudget(ConfMan.getInt("resource_cache_size") * 1024);
 }
 
 Resources::~Resources() {
-
-	while (!_resourceCache.empty()) {
-		CacheEntry *temp = _resourceCache.back();
-		_resourceCache.pop_back();
-		delete temp;
-	}
+	debugC(1, kDebugResource, "Resource cache: %d hits, %d misses, %d evictions", _resourceCache.getHits(), _resourceCache.getMisses(), _resourceCache.getEvictions());
+	_resourceCache.clear();
 
 	while (!_pakFiles.empty()) {
 		PakFile *temp = _pakFiles.back();
@@ -56,63 +54,31 @@ void Resources::removePackageFromCache(const Common::String &packName) {
 	// wandering back and forth between rooms. So for now, do nothing.
 }
 
+void Resources::freeCacheEntry(const Common::String &fileName, CacheEntry &entry, void *refCon) {
+	debugC(5, kDebugResource, "Freed %s (%s) to reclaim %d bytes", fileName.c_str(), entry._packName.c_str(), entry._size);
+	free(entry._data);
+	entry._data = 0;
+}
+
 bool Resources::getFromCache(const Common::String &fileName, uint32 *fileSize, uint8 **fileData) {
-	for (Common::Array<CacheEntry *>::iterator entry = _resourceCache.begin(); entry != _resourceCache.end(); ++entry) {
-		if ((*entry)->_data && (*entry)->_fileName.compareToIgnoreCase(fileName) == 0) {
-			debugC(5, kDebugResource, "getFromCache(%s) - Got %d bytes from %s", fileName.c_str(), (*entry)->_size, (*entry)->_packName.c_str());
-			(*entry)->_age = 0;
-			*fileSize = (*entry)->_size;
-			*fileData = (*entry)->_data;
-			return true;
-			}
-		}
-	return false;
+	CacheEntry *entry = _resourceCache.get(fileName);
+	if (!entry)
+		return false;
+
+	debugC(5, kDebugResource, "getFromCache(%s) - Got %d bytes from %s", fileName.c_str(), entry->_size, entry->_packName.c_str());
+	*fileSize = entry->_size;
+	*fileData = entry->_data;
+	return true;
 }
 
 void Resources::addToCache(const Common::String &packName, const Common::String &fileName, uint32 fileSize, uint8 *fileData) {
-	debugC(5, kDebugResource, "addToCache(%s, %s, %d) - Total Size: %d", packName.c_str(), fileName.c_str(), fileSize, _cacheSize + fileSize);
-	for (Common::Array<CacheEntry *>::iterator entry = _resourceCache.begin(); entry != _resourceCache.end(); ++entry) {
-		if ((*entry)->_data) {
-			(*entry)->_age++;
-		}
-	}
-	_cacheSize += fileSize;
-
-	while (_cacheSize > MAX_CACHE_SIZE) {
-		CacheEntry *bestEntry = 0;
-		for (Common::Array<CacheEntry *>::iterator entry = _resourceCache.begin(); entry != _resourceCache.end(); ++entry) {
-			if ((*entry)->_data) {
-				if (!bestEntry || ((*entry)->_age >= bestEntry->_age && (*entry)->_size >= bestEntry->_size)) {
-					bestEntry = *entry;
-				}
-			}
-		}
-		if (!bestEntry)
-			break;
-
-		free(bestEntry->_data);
-		bestEntry->_data = 0;
-		_cacheSize -= bestEntry->_size;
-		debugC(5, kDebugResource, "Freed %s (%s) to reclaim %d bytes", bestEntry->_fileName.c_str(), bestEntry->_packName.c_str(), bestEntry->_size);
-	}
-
-	for (Common::Array<CacheEntry *>::iterator entry = _resourceCache.begin(); entry != _resourceCache.end(); ++entry) {
-		if (!(*entry)->_data) {
-			(*entry)->_packName = packName;
-			(*entry)->_fileName = fileName;
-			(*entry)->_age = 0;
-			(*entry)->_size = fileSize;
-			(*entry)->_data = fileData;
-			return;
-		}
-	}
+	debugC(5, kDebugResource, "addToCache(%s, %s, %d) - Total Size: %d", packName.c_str(), fileName.c_str(), fileSize, _resourceCache.getSize() + fileSize);
 
-	CacheEntry *entry = new CacheEntry();
-	entry->_packName = packName;
-	entry->_fileName = fileName;
-	entry->_size = fileSize;
-	entry->_data = fileData;
-	_resourceCache.push_back(entry);
+	CacheEntry entry;
+	entry._packName = packName;
+	entry._size = fileSize;
+	entry._data = fileData;
+	_resourceCache.insert(fileName, entry, fileSize);
 }
 
 void Resources::openPackage(const Common::String &fileName) {
@@ -26,8 +26,12 @@
 #include "common/array.h"
 #include "common/str.h"
 #include "common/file.h"
+#include "common/hash-str.h"
+#include "common/resource-cache.h"
 #include "common/stream.h"
 
+// Default size of the resource cache, which can be changed with the
+// "resource_cache_size" setting (in kilobytes)
 #define MAX_CACHE_SIZE	(4 * 1024 * 1024)
 
 namespace Toon {
@@ -57,16 +61,8 @@ protected:
 
 class ToonEngine;
 
-class CacheEntry {
-public:
-	CacheEntry() : _age(0), _size(0), _data(0) {}
-	~CacheEntry() {
-		free(_data);
-	}
-
+struct CacheEntry {
 	Common::String _packName;
-	Common::String _fileName;
-	uint32 _age;
 	uint32 _size;
 	uint8 *_data;
 };
@@ -85,9 +81,9 @@ protected:
 	ToonEngine *_vm;
 	Common::Array<uint8 *> _allocatedFileData;
 	Common::Array<PakFile *> _pakFiles;
-	uint32 _cacheSize;
-	Common::Array<CacheEntry *> _resourceCache;
+	Common::ResourceCache<Common::String, CacheEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _resourceCache;
 
+	static void freeCacheEntry(const Common::String &fileName, CacheEntry &entry, void *refCon);
 	void removePackageFromCache(const Common::String &packName);
 	bool getFromCache(const Common::String &fileName, uint32 *fileSize, uint8 **fileData);
 	void addToCache(const Common::String &packName, const Common::String &fileName, uint32 fileSize, uint8 *fileData);
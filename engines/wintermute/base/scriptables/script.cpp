@@ -41,6 +41,7 @@ IMPLEMENT_PERSISTENT(ScScript, false)
 ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_buffer = nullptr;
 	_bufferSize = _iP = 0;
+	_compiled = nullptr;
 	_scriptStream = nullptr;
 	_filename = nullptr;
 	_currentLine = 0;
@@ -161,81 +162,29 @@ bool ScScript::initScript() {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initTables() {
-	uint32 origIP = _iP;
-
 	readHeader();
-	// load symbol table
-	_iP = _header.symbolTable;
-
-	_numSymbols = getDWORD();
-	_symbols = new char*[_numSymbols];
-	for (uint32 i = 0; i < _numSymbols; i++) {
-		uint32 index = getDWORD();
-		_symbols[index] = getString();
-	}
-
-	// load functions table
-	_iP = _header.funcTable;
-
-	_numFunctions = getDWORD();
-	_functions = new TFunctionPos[_numFunctions];
-	for (uint32 i = 0; i < _numFunctions; i++) {
-		_functions[i].pos = getDWORD();
-		_functions[i].name = getString();
-	}
-
-
-	// load events table
-	_iP = _header.eventTable;
-
-	_numEvents = getDWORD();
-	_events = new TEventPos[_numEvents];
-	for (uint32 i = 0; i < _numEvents; i++) {
-		_events[i].pos = getDWORD();
-		_events[i].name = getString();
-	}
-
-
-	// load externals
-	if (_header.version >= 0x0101) {
-		_iP = _header.externalsTable;
-
-		_numExternals = getDWORD();
-		_externals = new TExternalFunction[_numExternals];
-		for (uint32 i = 0; i < _numExternals; i++) {
-			_externals[i].dll_name = getString();
-			_externals[i].name = getString();
-			_externals[i].call_type = (TCallType)getDWORD();
-			_externals[i].returns = (TExternalType)getDWORD();
-			_externals[i].nu_params = getDWORD();
-			if (_externals[i].nu_params > 0) {
-				_externals[i].params = new TExternalType[_externals[i].nu_params];
-				for (int j = 0; j < _externals[i].nu_params; j++) {
-					_externals[i].params[j] = (TExternalType)getDWORD();
-				}
-			}
-		}
-	}
-
-	// load method table
-	_iP = _header.methodTable;
 
-	_numMethods = getDWORD();
-	_methods = new TMethodPos[_numMethods];
-	for (uint32 i = 0; i < _numMethods; i++) {
-		_methods[i].pos = getDWORD();
-		_methods[i].name = getString();
-	}
-
-
-	_iP = origIP;
+	// The tables are parsed only once per file and shared by all scripts
+	// running it
+	_compiled->initTables();
+
+	_symbols = _compiled->_symbols;
+	_numSymbols = _compiled->_numSymbols;
+	_functions = _compiled->_functions;
+	_numFunctions = _compiled->_numFunctions;
+	_methods = _compiled->_methods;
+	_numMethods = _compiled->_numMethods;
+	_events = _compiled->_events;
+	_numEvents = _compiled->_numEvents;
+	_externals = _compiled->_externals;
+	_numExternals = _compiled->_numExternals;
 
 	return STATUS_OK;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner) {
+bool ScScript::create(const char *filename, ScCompiledScript *compiled, BaseScriptHolder *owner) {
 	cleanup();
 
 	_thread = false;
@@ -249,14 +198,10 @@ bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScrip
 		strcpy(_filename, filename);
 	}
 
-	_buffer = new byte [size];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, buffer, size);
-
-	_bufferSize = size;
+	_compiled = compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	bool res = initScript();
 	if (DID_FAIL(res)) {
@@ -289,14 +234,11 @@ bool ScScript::createThread(ScScript *original, uint32 initIP, const Common::Str
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the buffer
+	_compiled = original->_compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	// initialize
 	bool res = initScript();
@@ -346,14 +288,11 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the buffer
+	_compiled = original->_compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	// initialize
 	bool res = initScript();
@@ -380,21 +319,29 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 
 //////////////////////////////////////////////////////////////////////////
 void ScScript::cleanup() {
-	if (_buffer) {
-		delete[] _buffer;
+	if (_compiled) {
+		_compiled->decRef();
 	}
+	_compiled = nullptr;
 	_buffer = nullptr;
+	_bufferSize = 0;
 
 	if (_filename) {
 		delete[] _filename;
 	}
 	_filename = nullptr;
 
-	if (_symbols) {
-		delete[] _symbols;
-	}
+	// The tables belong to the compiled script
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_functions = nullptr;
+	_numFunctions = 0;
+	_methods = nullptr;
+	_numMethods = 0;
+	_events = nullptr;
+	_numEvents = 0;
+	_externals = nullptr;
+	_numExternals = 0;
 
 	if (_globals && !_thread) {
 		delete _globals;
@@ -413,36 +360,6 @@ void ScScript::cleanup() {
 	delete _stack;
 	_stack = nullptr;
 
-	if (_functions) {
-		delete[] _functions;
-	}
-	_functions = nullptr;
-	_numFunctions = 0;
-
-	if (_methods) {
-		delete[] _methods;
-	}
-	_methods = nullptr;
-	_numMethods = 0;
-
-	if (_events) {
-		delete[] _events;
-	}
-	_events = nullptr;
-	_numEvents = 0;
-
-
-	if (_externals) {
-		for (uint32 i = 0; i < _numExternals; i++) {
-			if (_externals[i].nu_params > 0) {
-				delete[] _externals[i].params;
-			}
-		}
-		delete[] _externals;
-	}
-	_externals = nullptr;
-	_numExternals = 0;
-
 	delete _operand;
 	delete _reg1;
 	_operand = nullptr;
@@ -521,28 +438,39 @@ bool ScScript::executeInstruction() {
 	ScValue *op1;
 	ScValue *op2;
 
-	uint32 inst = getDWORD();
+	// Use the pre-decoded instruction, decode it here only if the code
+	// section could not be decoded in advance
+	uint32 ip = _iP;
+	ScCompiledScript::Instruction decoded;
+	const ScCompiledScript::Instruction *instr = _compiled->getInstruction(ip);
+	if (!instr) {
+		if (!_compiled->decodeInstruction(ip, decoded)) {
+			decoded.inst = (uint32)-1;
+			decoded.next = ip + sizeof(uint32);
+		}
+		instr = &decoded;
+	}
+	_iP = instr->next;
+
+	uint32 inst = instr->inst;
 	switch (inst) {
 
 	case II_DEF_VAR:
 		_operand->setNULL();
-		dw = getDWORD();
 		if (_scopeStack->_sP < 0) {
-			_globals->setProp(_symbols[dw], _operand);
+			_globals->setProp(instr->str, _operand);
 		} else {
-			_scopeStack->getTop()->setProp(_symbols[dw], _operand);
+			_scopeStack->getTop()->setProp(instr->str, _operand);
 		}
 
 		break;
 
 	case II_DEF_GLOB_VAR:
 	case II_DEF_CONST_VAR: {
-		dw = getDWORD();
-		/*      char *temp = _symbols[dw]; // TODO delete */
 		// only create global var if it doesn't exist
-		if (!_engine->_globals->propExists(_symbols[dw])) {
+		if (!_engine->_globals->propExists(instr->str)) {
 			_operand->setNULL();
-			_engine->_globals->setProp(_symbols[dw], _operand, false, inst == II_DEF_CONST_VAR);
+			_engine->_globals->setProp(instr->str, _operand, false, inst == II_DEF_CONST_VAR);
 		}
 		break;
 	}
@@ -571,7 +499,7 @@ bool ScScript::executeInstruction() {
 
 
 	case II_CALL:
-		dw = getDWORD();
+		dw = instr->dw;
 
 		_operand->setInt(_iP);
 		_callStack->push(_operand);
@@ -661,13 +589,11 @@ bool ScScript::executeInstruction() {
 	break;
 
 	case II_EXTERNAL_CALL: {
-		uint32 symbolIndex = getDWORD();
-
-		TExternalFunction *f = getExternal(_symbols[symbolIndex]);
+		TExternalFunction *f = getExternal(instr->str);
 		if (f) {
 			externalCall(_stack, _thisStack, f);
 		} else {
-			_gameRef->externalCall(this, _stack, _thisStack, _symbols[symbolIndex]);
+			_gameRef->externalCall(this, _stack, _thisStack, instr->str);
 		}
 
 		break;
@@ -678,7 +604,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_CORRECT_STACK:
-		dw = getDWORD(); // params expected
+		dw = instr->dw; // params expected
 		_stack->correctParams(dw);
 		break;
 
@@ -692,7 +618,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(instr->str);
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -703,14 +629,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(instr->str);
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
+		char *varName = instr->str;
 		ScValue *var = getVar(varName);
 		if (var) {
 			ScValue *val = _stack->pop();
@@ -737,21 +663,21 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_INT:
-		_stack->pushInt((int)getDWORD());
+		_stack->pushInt((int)instr->dw);
 		break;
 
 	case II_PUSH_FLOAT:
-		_stack->pushFloat(getFloat());
+		_stack->pushFloat(instr->f);
 		break;
 
 
 	case II_PUSH_BOOL:
-		_stack->pushBool(getDWORD() != 0);
+		_stack->pushBool(instr->dw != 0);
 
 		break;
 
 	case II_PUSH_STRING:
-		_stack->pushString(getString());
+		_stack->pushString(instr->str);
 		break;
 
 	case II_PUSH_NULL:
@@ -764,7 +690,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(instr->str));
 		_thisStack->push(_operand);
 		break;
 
@@ -808,11 +734,11 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_JMP:
-		_iP = getDWORD();
+		_iP = instr->dw;
 		break;
 
 	case II_JMP_FALSE: {
-		dw = getDWORD();
+		dw = instr->dw;
 		//if (!_stack->pop()->getBool()) _iP = dw;
 		ScValue *val = _stack->pop();
 		if (!val) {
@@ -1079,7 +1005,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_DBG_LINE: {
-		int newLine = getDWORD();
+		int newLine = instr->dw;
 		if (newLine != _currentLine) {
 			_currentLine = newLine;
 		}
@@ -1087,7 +1013,7 @@ bool ScScript::executeInstruction() {
 
 	}
 	default:
-		_gameRef->LOG(0, "Fatal: Invalid instruction %d ('%s', line %d, IP:0x%x)\n", inst, _filename, _currentLine, _iP - sizeof(uint32));
+		_gameRef->LOG(0, "Fatal: Invalid instruction %d ('%s', line %d, IP:0x%x)\n", inst, _filename, _currentLine, ip);
 		_state = SCRIPT_FINISHED;
 		ret = STATUS_FAILED;
 	} // switch(instruction)
@@ -1100,23 +1026,13 @@ bool ScScript::executeInstruction() {
 
 //////////////////////////////////////////////////////////////////////////
 uint32 ScScript::getFuncPos(const Common::String &name) {
-	for (uint32 i = 0; i < _numFunctions; i++) {
-		if (name == _functions[i].name) {
-			return _functions[i].pos;
-		}
-	}
-	return 0;
+	return _compiled ? _compiled->getFuncPos(name) : 0;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 uint32 ScScript::getMethodPos(const Common::String &name) const {
-	for (uint32 i = 0; i < _numMethods; i++) {
-		if (name == _methods[i].name) {
-			return _methods[i].pos;
-		}
-	}
-	return 0;
+	return _compiled ? _compiled->getMethodPos(name) : 0;
 }
 
 
@@ -1260,12 +1176,16 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 	} else {
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
-			_buffer = new byte[_bufferSize];
-			persistMgr->getBytes(_buffer, _bufferSize);
+			byte *buffer = new byte[_bufferSize];
+			persistMgr->getBytes(buffer, _bufferSize);
+			_compiled = new ScCompiledScript(buffer, _bufferSize);
+			_compiled->incRef();
+			_buffer = _compiled->_buffer;
 			_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
 			initTables();
 		} else {
 			_buffer = nullptr;
+			_compiled = nullptr;
 			_scriptStream = nullptr;
 		}
 	}
@@ -1335,12 +1255,7 @@ ScScript *ScScript::invokeEventHandler(const Common::String &eventName, bool unb
 
 //////////////////////////////////////////////////////////////////////////
 uint32 ScScript::getEventPos(const Common::String &name) const {
-	for (int i = _numEvents - 1; i >= 0; i--) {
-		if (scumm_stricmp(name.c_str(), _events[i].name) == 0) {
-			return _events[i].pos;
-		}
-	}
-	return 0;
+	return _compiled ? _compiled->getEventPos(name) : 0;
 }
 
 
@@ -1449,15 +1364,16 @@ const char *ScScript::dbgGetFilename() {
 //////////////////////////////////////////////////////////////////////////
 void ScScript::afterLoad() {
 	if (_buffer == nullptr) {
-		byte *buffer = _engine->getCompiledScript(_filename, &_bufferSize);
-		if (!buffer) {
+		_compiled = _engine->getCompiledScript(_filename);
+		if (!_compiled) {
 			_gameRef->LOG(0, "Error reinitializing script '%s' after load. Script will be terminated.", _filename);
 			_state = SCRIPT_ERROR;
 			return;
 		}
 
-		_buffer = new byte [_bufferSize];
-		memcpy(_buffer, buffer, _bufferSize);
+		_compiled->incRef();
+		_buffer = _compiled->_buffer;
+		_bufferSize = _compiled->_size;
 
 		delete _scriptStream;
 		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
@@ -1466,4 +1382,293 @@ void ScScript::afterLoad() {
 	}
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+ScCompiledScript::ScCompiledScript(byte *buffer, uint32 size) {
+	_buffer = buffer;
+	_size = size;
+	_refCount = 0;
+	_tablesLoaded = false;
+
+	_symbols = nullptr;
+	_numSymbols = 0;
+	_functions = nullptr;
+	_numFunctions = 0;
+	_methods = nullptr;
+	_numMethods = 0;
+	_events = nullptr;
+	_numEvents = 0;
+	_externals = nullptr;
+	_numExternals = 0;
+
+	_codeStart = _codeEnd = 0;
+	_codeIndex = nullptr;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScCompiledScript::~ScCompiledScript() {
+	delete[] _codeIndex;
+
+	delete[] _symbols;
+	delete[] _functions;
+	delete[] _methods;
+	delete[] _events;
+
+	for (uint32 i = 0; i < _numExternals; i++) {
+		if (_externals[i].nu_params > 0) {
+			delete[] _externals[i].params;
+		}
+	}
+	delete[] _externals;
+
+	delete[] _buffer;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScCompiledScript::decRef() {
+	assert(_refCount > 0);
+	if (--_refCount == 0) {
+		delete this;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::readDWORD(uint32 &pos) const {
+	uint32 ret = READ_LE_UINT32(_buffer + pos);
+	pos += sizeof(uint32);
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+char *ScCompiledScript::readString(uint32 &pos) const {
+	char *ret = (char *)(_buffer + pos);
+	pos += strlen(ret) + 1;
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScCompiledScript::initTables() {
+	if (_tablesLoaded) {
+		return;
+	}
+	_tablesLoaded = true;
+
+	uint32 pos = 8;
+	const uint32 codeStart = readDWORD(pos);
+	const uint32 funcTable = readDWORD(pos);
+	const uint32 symbolTable = readDWORD(pos);
+	const uint32 eventTable = readDWORD(pos);
+	const uint32 externalsTable = readDWORD(pos);
+	const uint32 methodTable = readDWORD(pos);
+	const uint32 version = READ_LE_UINT32(_buffer + 4);
+
+	// load symbol table
+	pos = symbolTable;
+	_numSymbols = readDWORD(pos);
+	_symbols = new char*[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		uint32 index = readDWORD(pos);
+		_symbols[index] = readString(pos);
+	}
+
+	// load functions table, the first function of a name wins
+	pos = funcTable;
+	_numFunctions = readDWORD(pos);
+	_functions = new ScScript::TFunctionPos[_numFunctions];
+	for (uint32 i = 0; i < _numFunctions; i++) {
+		_functions[i].pos = readDWORD(pos);
+		_functions[i].name = readString(pos);
+		if (!_functionPos.contains(_functions[i].name)) {
+			_functionPos[_functions[i].name] = _functions[i].pos;
+		}
+	}
+
+	// load events table, the last event of a name wins
+	pos = eventTable;
+	_numEvents = readDWORD(pos);
+	_events = new ScScript::TEventPos[_numEvents];
+	for (uint32 i = 0; i < _numEvents; i++) {
+		_events[i].pos = readDWORD(pos);
+		_events[i].name = readString(pos);
+		_eventPos[_events[i].name] = _events[i].pos;
+	}
+
+	// load externals
+	if (version >= 0x0101) {
+		pos = externalsTable;
+		_numExternals = readDWORD(pos);
+		_externals = new ScScript::TExternalFunction[_numExternals];
+		for (uint32 i = 0; i < _numExternals; i++) {
+			_externals[i].dll_name = readString(pos);
+			_externals[i].name = readString(pos);
+			_externals[i].call_type = (TCallType)readDWORD(pos);
+			_externals[i].returns = (TExternalType)readDWORD(pos);
+			_externals[i].nu_params = readDWORD(pos);
+			if (_externals[i].nu_params > 0) {
+				_externals[i].params = new TExternalType[_externals[i].nu_params];
+				for (int j = 0; j < _externals[i].nu_params; j++) {
+					_externals[i].params[j] = (TExternalType)readDWORD(pos);
+				}
+			}
+		}
+	}
+
+	// load method table, the first method of a name wins
+	pos = methodTable;
+	_numMethods = readDWORD(pos);
+	_methods = new ScScript::TMethodPos[_numMethods];
+	for (uint32 i = 0; i < _numMethods; i++) {
+		_methods[i].pos = readDWORD(pos);
+		_methods[i].name = readString(pos);
+		if (!_methodPos.contains(_methods[i].name)) {
+			_methodPos[_methods[i].name] = _methods[i].pos;
+		}
+	}
+
+	// the code section ends where the first table starts
+	const uint32 tables[] = { funcTable, symbolTable, eventTable, externalsTable, methodTable };
+	uint32 codeEnd = _size;
+	for (int i = 0; i < ARRAYSIZE(tables); i++) {
+		if (tables[i] > codeStart && tables[i] < codeEnd) {
+			codeEnd = tables[i];
+		}
+	}
+	decodeCode(codeStart, codeEnd);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool ScCompiledScript::decodeInstruction(uint32 pos, Instruction &instr) const {
+	if (pos > _size || _size - pos < sizeof(uint32)) {
+		return false;
+	}
+	instr.inst = readDWORD(pos);
+	instr.dw = 0;
+
+	switch (instr.inst) {
+	case II_DEF_VAR:
+	case II_DEF_GLOB_VAR:
+	case II_DEF_CONST_VAR:
+	case II_EXTERNAL_CALL:
+	case II_PUSH_VAR:
+	case II_PUSH_VAR_REF:
+	case II_POP_VAR:
+	case II_PUSH_THIS: {
+		if (_size - pos < sizeof(uint32)) {
+			return false;
+		}
+		uint32 index = readDWORD(pos);
+		if (index >= _numSymbols) {
+			return false;
+		}
+		instr.str = _symbols[index];
+		break;
+	}
+
+	case II_CALL:
+	case II_CORRECT_STACK:
+	case II_PUSH_INT:
+	case II_PUSH_BOOL:
+	case II_JMP:
+	case II_JMP_FALSE:
+	case II_DBG_LINE:
+		if (_size - pos < sizeof(uint32)) {
+			return false;
+		}
+		instr.dw = readDWORD(pos);
+		break;
+
+	case II_PUSH_FLOAT: {
+		if (_size - pos < 8) {
+			return false;
+		}
+		byte buffer[8];
+		memcpy(buffer, _buffer + pos, 8);
+
+#ifdef SCUMM_BIG_ENDIAN
+		// TODO: For lack of a READ_LE_UINT64
+		SWAP(buffer[0], buffer[7]);
+		SWAP(buffer[1], buffer[6]);
+		SWAP(buffer[2], buffer[5]);
+		SWAP(buffer[3], buffer[4]);
+#endif
+
+		memcpy(&instr.f, buffer, sizeof(double));
+		pos += 8; // Hardcode the double-size used originally.
+		break;
+	}
+
+	case II_PUSH_STRING:
+		if (!memchr(_buffer + pos, '\0', _size - pos)) {
+			return false;
+		}
+		instr.str = readString(pos);
+		break;
+
+	default:
+		// no operand
+		break;
+	}
+
+	instr.next = pos;
+	return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScCompiledScript::decodeCode(uint32 start, uint32 end) {
+	if (start >= end || end > _size) {
+		return;
+	}
+
+	_codeStart = start;
+	_codeEnd = end;
+	_codeIndex = new int32[end - start];
+	for (uint32 i = 0; i < end - start; i++) {
+		_codeIndex[i] = -1;
+	}
+
+	// The instructions follow each other without gaps. If decoding fails,
+	// the remaining instructions are decoded when they are executed.
+	uint32 pos = start;
+	Instruction instr;
+	while (pos < end && decodeInstruction(pos, instr) && instr.inst <= II_DEF_CONST_VAR && instr.next <= end) {
+		_codeIndex[pos - start] = _code.size();
+		_code.push_back(instr);
+		pos = instr.next;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::getMemorySize() const {
+	return _size + (_codeEnd - _codeStart) * sizeof(int32) + _code.size() * sizeof(Instruction);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::getFuncPos(const Common::String &name) const {
+	PosMap::const_iterator i = _functionPos.find(name);
+	return i != _functionPos.end() ? i->_value : 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::getMethodPos(const Common::String &name) const {
+	PosMap::const_iterator i = _methodPos.find(name);
+	return i != _methodPos.end() ? i->_value : 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::getEventPos(const Common::String &name) const {
+	EventPosMap::const_iterator i = _eventPos.find(name);
+	return i != _eventPos.end() ? i->_value : 0;
+}
+
 } // End of namespace Wintermute
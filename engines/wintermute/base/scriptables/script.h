@@ -33,10 +33,12 @@
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
 #include "engines/wintermute/coll_templ.h"
+#include "common/hash-str.h"
 
 namespace Wintermute {
 class BaseScriptHolder;
 class BaseObject;
+class ScCompiledScript;
 class ScEngine;
 class ScStack;
 class ScScript : public BaseClass {
@@ -130,12 +132,13 @@ public:
 	uint32 getDWORD();
 	double getFloat();
 	void cleanup();
-	bool create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner);
+	bool create(const char *filename, ScCompiledScript *compiled, BaseScriptHolder *owner);
 	uint32 _iP;
 private:
 	void readHeader();
 	uint32 _bufferSize;
 	byte *_buffer;
+	ScCompiledScript *_compiled;
 public:
 	Common::SeekableReadStream *_scriptStream;
 	ScScript(BaseGame *inGame, ScEngine *engine);
@@ -169,6 +172,103 @@ public:
 	virtual const char *dbgGetFilename();
 };
 
+/**
+ * A loaded script file along with its symbol, function, event, method and
+ * externals tables, which point into the file buffer. It is shared by the
+ * script cache of ScEngine and all scripts and threads running the file,
+ * and deleted once the last of them released it.
+ */
+class ScCompiledScript {
+public:
+	/**
+	 * A decoded instruction. Symbol operands are resolved to the symbol
+	 * name, all other operands are taken over as they are.
+	 */
+	struct Instruction {
+		uint32 inst;
+		uint32 next; ///< offset of the following instruction
+		union {
+			uint32 dw;
+			double f;
+			char *str;
+		};
+	};
+
+	/** Takes ownership of buffer, which must have been allocated with new[]. */
+	ScCompiledScript(byte *buffer, uint32 size);
+
+	void incRef() { _refCount++; }
+	void decRef();
+
+	/**
+	 * Parse the tables and decode the code section, unless that has been
+	 * done already.
+	 */
+	void initTables();
+
+	/**
+	 * Decode the instruction at the given offset.
+	 * @return	false if the instruction or its operand lies outside of the
+	 *			script, or refers to an unknown symbol
+	 */
+	bool decodeInstruction(uint32 pos, Instruction &instr) const;
+
+	/**
+	 * Return the pre-decoded instruction at the given offset, or nullptr
+	 * if the offset is not the start of an instruction of the code section.
+	 */
+	const Instruction *getInstruction(uint32 pos) const {
+		if (pos < _codeStart || pos >= _codeEnd || _codeIndex[pos - _codeStart] < 0) {
+			return nullptr;
+		}
+		return &_code[_codeIndex[pos - _codeStart]];
+	}
+
+	/** Return the memory used by the buffer and the decoded code (in bytes). */
+	uint32 getMemorySize() const;
+
+	uint32 getFuncPos(const Common::String &name) const;
+	uint32 getMethodPos(const Common::String &name) const;
+	uint32 getEventPos(const Common::String &name) const;
+
+	byte *_buffer;
+	uint32 _size;
+
+	char **_symbols;
+	uint32 _numSymbols;
+	ScScript::TFunctionPos *_functions;
+	uint32 _numFunctions;
+	ScScript::TMethodPos *_methods;
+	uint32 _numMethods;
+	ScScript::TEventPos *_events;
+	uint32 _numEvents;
+	ScScript::TExternalFunction *_externals;
+	uint32 _numExternals;
+
+private:
+	~ScCompiledScript();
+
+	uint32 readDWORD(uint32 &pos) const;
+	char *readString(uint32 &pos) const;
+	void decodeCode(uint32 start, uint32 end);
+
+	typedef Common::HashMap<Common::String, uint32> PosMap;
+	typedef Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> EventPosMap;
+
+	uint32 _refCount;
+	bool _tablesLoaded;
+	PosMap _functionPos;
+	PosMap _methodPos;
+	EventPosMap _eventPos;
+
+	// The code section decoded in advance, _codeIndex maps each offset of
+	// the code section to the index of the instruction starting there, or -1
+	uint32 _codeStart;
+	uint32 _codeEnd;
+	int32 *_codeIndex;
+	Common::Array<Instruction> _code;
+};
+
 } // End of namespace Wintermute
 
 #endif
@@ -67,11 +67,6 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 		_globals->setProp("Math", &val);
 	}
 
-	// prepare script cache
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		_cachedScripts[i] = nullptr;
-	}
-
 	_currentScript = nullptr;
 
 	_isProfiling = false;
@@ -134,18 +129,15 @@ void ScEngine::parseElement(void *data, int line, int type, void *elementData) {
 
 //////////////////////////////////////////////////////////////////////////
 ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
-	byte *compBuffer;
-	uint32 compSize;
-
 	// get script from cache
-	compBuffer = getCompiledScript(filename, &compSize);
-	if (!compBuffer) {
+	ScCompiledScript *compiled = getCompiledScript(filename);
+	if (!compiled) {
 		return nullptr;
 	}
 
 	// add new script
 	ScScript *script = new ScScript(_gameRef, this);
-	bool ret = script->create(filename, compBuffer, compSize, owner);
+	bool ret = script->create(filename, compiled, owner);
 	if (DID_FAIL(ret)) {
 		_gameRef->LOG(ret, "Error running script '%s'...", filename);
 		delete script;
@@ -170,22 +162,16 @@ ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
 
 
 //////////////////////////////////////////////////////////////////////////
-byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache) {
+ScCompiledScript *ScEngine::getCompiledScript(const char *filename, bool ignoreCache) {
 	// is script in cache?
 	if (!ignoreCache) {
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] && scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
-				_cachedScripts[i]->_timestamp = g_system->getMillis();
-				*outSize = _cachedScripts[i]->_size;
-				return _cachedScripts[i]->_buffer;
-			}
+		ScCompiledScript **cached = _cachedScripts.get(filename);
+		if (cached) {
+			return *cached;
 		}
 	}
 
 	// nope, load it
-	byte *compBuffer;
-	uint32 compSize;
-
 	uint32 size;
 
 	byte *buffer = BaseEngine::instance().getFileManager()->readWholeFile(filename, &size);
@@ -195,10 +181,7 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 	}
 
 	// needs to be compiled?
-	if (FROM_LE_32(*(uint32 *)buffer) == SCRIPT_MAGIC) {
-		compBuffer = buffer;
-		compSize = size;
-	} else {
+	if (FROM_LE_32(*(uint32 *)buffer) != SCRIPT_MAGIC) {
 		if (!_compilerAvailable) {
 			_gameRef->LOG(0, "ScEngine::GetCompiledScript - script '%s' needs to be compiled but compiler is not available", filename);
 			delete[] buffer;
@@ -209,41 +192,22 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 		error("Script needs compilation, ScummVM does not contain a WME compiler");
 	}
 
-	byte *ret = nullptr;
-
-	// add script to cache
-	CScCachedScript *cachedScript = new CScCachedScript(filename, compBuffer, compSize);
-	if (cachedScript) {
-		int index = 0;
-		uint32 minTime = g_system->getMillis();
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] == nullptr) {
-				index = i;
-				break;
-			} else if (_cachedScripts[i]->_timestamp <= minTime) {
-				minTime = _cachedScripts[i]->_timestamp;
-				index = i;
-			}
-		}
-
-		if (_cachedScripts[index] != nullptr) {
-			delete _cachedScripts[index];
-		}
-		_cachedScripts[index] = cachedScript;
-
-		ret = cachedScript->_buffer;
-		*outSize = cachedScript->_size;
-	}
+	// add script to cache, with its tables and code already decoded
+	ScCompiledScript *compiled = new ScCompiledScript(buffer, size);
+	compiled->initTables();
+	compiled->incRef();
+	_cachedScripts.insert(filename, compiled, compiled->getMemorySize());
 
+	return compiled;
+}
 
-	// cleanup
-	delete[] buffer;
 
-	return ret;
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::ScriptCache::releaseScript(const Common::String &filename, ScCompiledScript *&script, void *refCon) {
+	script->decRef();
 }
 
 
-
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::tick() {
 	if (_scripts.size() == 0) {
@@ -446,12 +410,7 @@ int ScEngine::getNumScripts(int *running, int *waiting, int *persistent) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::emptyScriptCache() {
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		if (_cachedScripts[i]) {
-			delete _cachedScripts[i];
-			_cachedScripts[i] = nullptr;
-		}
-	}
+	_cachedScripts.clear();
 	return STATUS_OK;
 }
 
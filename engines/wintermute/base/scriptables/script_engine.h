@@ -32,40 +32,20 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
+#include "common/hash-str.h"
+#include "common/resource-cache.h"
 
 namespace Wintermute {
 
-#define MAX_CACHED_SCRIPTS 20
+// Total size of the script files kept in the cache (in bytes)
+#define SCRIPT_CACHE_SIZE (4 * 1024 * 1024)
+class ScCompiledScript;
 class ScScript;
 class ScValue;
 class BaseObject;
 class BaseScriptHolder;
 class ScEngine : public BaseClass {
 public:
-	class CScCachedScript {
-	public:
-		CScCachedScript(const char *filename, byte *buffer, uint32 size) {
-			_timestamp = g_system->getMillis();
-			_buffer = new byte[size];
-			if (_buffer) {
-				memcpy(_buffer, buffer, size);
-			}
-			_size = size;
-			_filename = filename;
-		};
-
-		~CScCachedScript() {
-			if (_buffer) {
-				delete[] _buffer;
-			}
-		};
-
-		uint32 _timestamp;
-		byte *_buffer;
-		uint32 _size;
-		Common::String _filename;
-	};
-
 	class CScBreakpoint {
 	public:
 		CScBreakpoint(const char *filename) {
@@ -93,7 +73,22 @@ public:
 	bool resetObject(BaseObject *Object);
 	bool resetScript(ScScript *script);
 	bool emptyScriptCache();
-	byte *getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache = false);
+	/**
+	 * Get a script file from the cache, loading it if necessary. The
+	 * returned script is owned by the cache, callers which keep it
+	 * around have to add a reference.
+	 */
+	ScCompiledScript *getCompiledScript(const char *filename, bool ignoreCache = false);
+
+	/** @name Script cache statistics */
+	//@{
+	uint getCachedScriptCount() const { return _cachedScripts.getCount(); }
+	uint32 getScriptCacheSize() const { return _cachedScripts.getSize(); }
+	uint32 getScriptCacheBudget() const { return _cachedScripts.getBudget(); }
+	uint32 getScriptCacheHits() const { return _cachedScripts.getHits(); }
+	uint32 getScriptCacheMisses() const { return _cachedScripts.getMisses(); }
+	uint32 getScriptCacheEvictions() const { return _cachedScripts.getEvictions(); }
+	//@}
 	DECLARE_PERSISTENT(ScEngine, BaseClass)
 	bool cleanup();
 	int getNumScripts(int *running = nullptr, int *waiting = nullptr, int *persistent = nullptr);
@@ -121,7 +116,15 @@ public:
 
 private:
 
-	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
+	class ScriptCache : public Common::ResourceCache<Common::String, ScCompiledScript *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> {
+	public:
+		ScriptCache() : ResourceCache(SCRIPT_CACHE_SIZE, releaseScript) {}
+	private:
+		static void releaseScript(const Common::String &filename, ScCompiledScript *&script, void *refCon);
+	};
+
+	ScriptCache _cachedScripts;
+
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
@@ -25,12 +25,14 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/scriptables/script_engine.h"
 
 namespace Wintermute {
 
 Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("script_cache", WRAP_METHOD(Console, Cmd_ScriptCache));
 }
 
 Console::~Console(void) {
@@ -81,4 +83,21 @@ bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ScriptCache(int argc, const char **argv) {
+	ScEngine *scEngine = _engineRef->_game ? _engineRef->_game->_scEngine : nullptr;
+	if (!scEngine) {
+		debugPrintf("Script engine not running\n");
+		return true;
+	}
+
+	uint32 hits = scEngine->getScriptCacheHits();
+	uint32 misses = scEngine->getScriptCacheMisses();
+	uint32 lookups = hits + misses;
+
+	debugPrintf("Cached scripts: %u (%u of %u KB)\n", scEngine->getCachedScriptCount(), scEngine->getScriptCacheSize() / 1024, scEngine->getScriptCacheBudget() / 1024);
+	debugPrintf("Hits: %u, misses: %u, hit rate: %u%%\n", hits, misses, lookups ? (uint32)((uint64)hits * 100 / lookups) : 0);
+	debugPrintf("Evictions: %u\n", scEngine->getScriptCacheEvictions());
+	return true;
+}
+
 } // End of namespace Wintermute
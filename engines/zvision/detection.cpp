@@ -106,6 +106,13 @@ static const ExtraGuiOption ZVisionExtraGuiOption = {
 	false
 };
 
+static const ExtraGuiOption ZVisionExtraGuiOptionSmoothWarp = {
+	_s("Smooth panorama and tilt views"),
+	_s("Use bilinear filtering when warping panoramas and tilted views"),
+	"smoothwarp",
+	false
+};
+
 class ZVisionMetaEngine : public AdvancedMetaEngine {
 public:
 	ZVisionMetaEngine() : AdvancedMetaEngine(ZVision::gameDescriptions, sizeof(ZVision::ZVisionGameDescription), zVisionGames) {
@@ -162,6 +169,7 @@ bool ZVisionMetaEngine::createInstance(OSystem *syst, Engine **engine, const ADG
 const ExtraGuiOptions ZVisionMetaEngine::getExtraGuiOptions(const Common::String &target) const {
 	ExtraGuiOptions options;
 	options.push_back(ZVisionExtraGuiOption);
+	options.push_back(ZVisionExtraGuiOptionSmoothWarp);
 	return options;
 }
 
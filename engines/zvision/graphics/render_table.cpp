@@ -25,6 +25,8 @@
 #include "zvision/graphics/render_table.h"
 
 #include "common/rect.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 #include "graphics/colormasks.h"
 
@@ -34,14 +36,23 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 		: _numRows(numRows),
 		  _numColumns(numColumns),
-		  _renderState(FLAT) {
+		  _renderState(FLAT),
+		  _bilinearFiltering(false) {
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+
+	uint warpSize = MAX(numRows, numColumns);
+	_warpPosition = new int32[warpSize];
+	_warpBase = new int32[warpSize];
+	_warpStep = new int32[warpSize];
 }
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _warpPosition;
+	delete[] _warpBase;
+	delete[] _warpStep;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -103,26 +114,95 @@ uint16 mixTwoRGB(uint16 colorOne, uint16 colorTwo, float percentColorOne) {
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16* destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
+	MutateParams params;
+	params.table = this;
+	params.sourceBuffer = sourceBuffer;
+	params.destBuffer = destBuffer;
+	params.destWidth = destWidth;
+	params.subRect = subRect;
+
+	// Every row only reads from sourceBuffer and writes its own part of
+	// destBuffer, so the rows can be warped independently
+	g_system->getThreadPool()->parallelFor(subRect.top, subRect.bottom, mutateRowsProc, &params, 16);
+}
+
+void RenderTable::mutateRowsProc(int begin, int end, void *refCon) {
+	MutateParams *params = (MutateParams *)refCon;
+	RenderTable *table = params->table;
+	uint16 *destRow = params->destBuffer + (begin - params->subRect.top) * params->destWidth;
 
-	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+	for (int y = begin; y < end; ++y) {
+		if (table->_bilinearFiltering)
+			table->mutateRowBilinear(params->sourceBuffer, destRow, y, params->subRect.left, params->subRect.right);
+		else
+			table->mutateRowNearest(params->sourceBuffer, destRow, y, params->subRect.left, params->subRect.right);
 
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
+		destRow += params->destWidth;
+	}
+}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+void RenderTable::mutateRowNearest(const uint16 *sourceBuffer, uint16 *destRow, int16 y, int16 left, int16 right) {
+	uint32 sourceOffset = y * _numColumns;
 
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+	for (int16 x = left; x < right; ++x) {
+		uint32 index = sourceOffset + x;
 
-		destOffset += destWidth;
+		// RenderTable only stores offsets from the original coordinates
+		uint32 sourceYIndex = y + _internalBuffer[index].y;
+		uint32 sourceXIndex = x + _internalBuffer[index].x;
+
+		destRow[x - left] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
+	}
+}
+
+void RenderTable::mutateRowBilinear(const uint16 *sourceBuffer, uint16 *destRow, int16 y, int16 left, int16 right) {
+	if (_renderState == PANORAMA) {
+		for (int16 x = left; x < right; ++x)
+			destRow[x - left] = sampleBilinear(sourceBuffer, _warpPosition[x], _warpBase[x] + y * _warpStep[x]);
+	} else {
+		int32 sourceY = _warpPosition[y];
+		int32 sourceX = _warpBase[y] + left * _warpStep[y];
+
+		for (int16 x = left; x < right; ++x) {
+			destRow[x - left] = sampleBilinear(sourceBuffer, sourceX, sourceY);
+			sourceX += _warpStep[y];
+		}
 	}
 }
 
+/**
+ * Spread an RGB565 color over 32 bits (green in the upper half), so that
+ * all three components can be scaled by a 5 bit weight at once.
+ */
+static inline uint32 spreadRGB565(uint16 color) {
+	return (color | (color << 16)) & 0x07E0F81F;
+}
+
+static inline uint32 lerpSpreadRGB565(uint32 colorOne, uint32 colorTwo, uint32 weightTwo) {
+	return ((colorOne * (32 - weightTwo) + colorTwo * weightTwo) >> 5) & 0x07E0F81F;
+}
+
+uint16 RenderTable::sampleBilinear(const uint16 *sourceBuffer, int32 x, int32 y) {
+	x = CLIP<int32>(x, 0, (_numColumns - 1) << 16);
+	y = CLIP<int32>(y, 0, (_numRows - 1) << 16);
+
+	uint32 x0 = x >> 16;
+	uint32 y0 = y >> 16;
+	uint32 x1 = MIN<uint32>(x0 + 1, _numColumns - 1);
+	uint32 y1 = MIN<uint32>(y0 + 1, _numRows - 1);
+	uint32 weightX = (x >> 11) & 31;
+	uint32 weightY = (y >> 11) & 31;
+
+	const uint16 *row0 = sourceBuffer + y0 * _numColumns;
+	const uint16 *row1 = sourceBuffer + y1 * _numColumns;
+
+	uint32 top = lerpSpreadRGB565(spreadRGB565(row0[x0]), spreadRGB565(row0[x1]), weightX);
+	uint32 bottom = lerpSpreadRGB565(spreadRGB565(row1[x0]), spreadRGB565(row1[x1]), weightX);
+	uint32 color = lerpSpreadRGB565(top, bottom, weightY);
+
+	return (uint16)(color | (color >> 16));
+}
+
 void RenderTable::generateRenderTable() {
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
@@ -138,7 +218,7 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	memset(_internalBuffer, 0, _numRows * _numColumns * sizeof(uint16));
+	memset(_internalBuffer, 0, _numRows * _numColumns * sizeof(Common::Point));
 
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
@@ -153,10 +233,16 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinder = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
+		int32 xInCylinderCoords = int32(floor(xInCylinder));
 
 		float cosAlpha = cos(alpha);
 
+		// Filtered rendering samples around pixel centers, hence the -0.5
+		_warpPosition[x] = int32(floor((xInCylinder - 0.5f) * 65536.0f));
+		_warpBase[x] = int32(floor((halfHeight - halfHeight * cosAlpha - 0.5f) * 65536.0f));
+		_warpStep[x] = int32(floor(cosAlpha * 65536.0f));
+
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
@@ -186,9 +272,14 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinder = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
+		int32 yInCylinderCoords = int32(floor(yInCylinder));
 
 		float cosAlpha = cos(alpha);
+
+		_warpPosition[y] = int32(floor((yInCylinder - 0.5f) * 65536.0f));
+		_warpBase[y] = int32(floor((halfWidth - halfWidth * cosAlpha - 0.5f) * 65536.0f));
+		_warpStep[y] = int32(floor(cosAlpha * 65536.0f));
 		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
@@ -44,6 +44,26 @@ private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
 	RenderState _renderState;
+	bool _bilinearFiltering;
+
+	/**
+	 * The warp only depends on the column (panorama) or the row (tilt),
+	 * so it is also kept per column/row, in 16.16 fixed point, for
+	 * filtered rendering. Along the warped axis the source position is
+	 * _warpPosition[i], across it the source position of pixel j is
+	 * _warpBase[i] + j * _warpStep[i].
+	 */
+	int32 *_warpPosition;
+	int32 *_warpBase;
+	int32 *_warpStep;
+
+	struct MutateParams {
+		RenderTable *table;
+		const uint16 *sourceBuffer;
+		uint16 *destBuffer;
+		uint32 destWidth;
+		Common::Rect subRect;
+	};
 
 	struct {
 		float fieldOfView;
@@ -64,9 +84,21 @@ public:
 
 	const Common::Point convertWarpedCoordToFlatCoord(const Common::Point &point);
 
+	/**
+	 * Warp subRect of sourceBuffer (which has the size of the table) into
+	 * destBuffer. The rows are split among the threads of the system
+	 * thread pool.
+	 */
 	void mutateImage(uint16 *sourceBuffer, uint16* destBuffer, uint32 destWidth, const Common::Rect &subRect);
 	void generateRenderTable();
 
+	/**
+	 * Interpolate between the four nearest source pixels instead of
+	 * taking the nearest one. The buffers are expected to be RGB565.
+	 */
+	void setBilinearFiltering(bool enable) { _bilinearFiltering = enable; }
+	bool getBilinearFiltering() const { return _bilinearFiltering; }
+
 	void setPanoramaFoV(float fov);
 	void setPanoramaScale(float scale);
 	void setPanoramaReverse(bool reverse);
@@ -76,6 +108,11 @@ public:
 	void setTiltReverse(bool reverse);
 
 private:
+	static void mutateRowsProc(int begin, int end, void *refCon);
+	void mutateRowNearest(const uint16 *sourceBuffer, uint16 *destRow, int16 y, int16 left, int16 right);
+	void mutateRowBilinear(const uint16 *sourceBuffer, uint16 *destRow, int16 y, int16 left, int16 right);
+	uint16 sampleBilinear(const uint16 *sourceBuffer, int32 x, int32 y);
+
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
 };
@@ -63,6 +63,8 @@ ZVision::ZVision(OSystem *syst, const ZVisionGameDescription *gameDesc)
 		  _cursorManager(nullptr) {
 
 	debug(1, "ZVision::ZVision");
+
+	ConfMan.registerDefault("smoothwarp", false);
 }
 
 ZVision::~ZVision() {
@@ -118,6 +120,7 @@ void ZVision::initialize() {
 	// Create managers
 	_scriptManager = new ScriptManager(this);
 	_renderManager = new RenderManager(_system, WINDOW_WIDTH, WINDOW_HEIGHT, _workingWindow, _pixelFormat);
+	_renderManager->getRenderTable()->setBilinearFiltering(ConfMan.getBool("smoothwarp"));
 	_saveManager = new SaveManager(this);
 	_stringManager = new StringManager(this);
 	_cursorManager = new CursorManager(this, &_pixelFormat);
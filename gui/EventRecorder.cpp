@@ -20,11 +20,23 @@
  *
  */
 
+// The benchmark timer uses gettimeofday() from sys/time.h
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#undef ARRAYSIZE // winnt.h defines ARRAYSIZE, but we want our own one...
+#endif
 
 #include "gui/EventRecorder.h"
 
 #ifdef ENABLE_EVENTRECORDER
 
+#ifdef POSIX
+#include <sys/time.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
@@ -37,6 +49,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/onscreendialog.h"
+#include "common/algorithm.h"
 #include "common/random.h"
 #include "common/savefile.h"
 #include "common/textconsole.h"
@@ -90,6 +103,16 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = 0;
 
+	_benchmark = false;
+	_benchmarkReported = false;
+	_benchmarkStartTime = 0;
+	_frameStartTime = 0;
+	for (int i = 0; i < kBenchmarkSectionCount; i++) {
+		_sectionStartTime[i] = 0;
+		_frameSectionTime[i] = 0;
+		_totalSectionTime[i] = 0;
+	}
+
 	DebugMan.addDebugChannel(kDebugLevelEventRec, "EventRec", "Event recorder debug level");
 }
 
@@ -103,6 +126,10 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_benchmark) {
+		reportBenchmark();
+		_benchmark = false;
+	}
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -154,6 +181,13 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_nextEvent = _playbackFile->getNextEvent();
 			_timerManager->handler();
 		} else {
+			if (_benchmark && (_nextEvent.type == Common::EVENT_RTL || _nextEvent.type == Common::EVENT_QUIT || _nextEvent.type == Common::EVENT_INVALID)) {
+				// The whole recording has been replayed
+				reportBenchmark();
+				g_system->quit();
+				millis = _fakeTimer;
+				return;
+			}
 			if (_nextEvent.type == Common::EVENT_RTL) {
 				error("playback:action=stopplayback");
 			} else {
@@ -271,6 +305,7 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	_playbackFile = new Common::PlaybackFile();
 	_lastScreenshotTime = 0;
 	_recordMode = mode;
+	_recordFileName = recordFileName;
 	_needcontinueGame = false;
 	if (ConfMan.hasKey("disable_display")) {
 		DebugMan.enableDebugChannel("EventRec");
@@ -295,6 +330,9 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	if (_recordMode == kRecorderPlayback) {
 		applyPlaybackSettings();
 		_nextEvent = _playbackFile->getNextEvent();
+		if (ConfMan.getBool("benchmark")) {
+			initBenchmark();
+		}
 	}
 	if (_recordMode == kRecorderRecord) {
 		getConfig();
@@ -431,7 +469,9 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
+	beginBenchmarkSection(kBenchmarkAudio);
 	_fakeMixerManager->update();
+	endBenchmarkSection(kBenchmarkAudio);
 	_recordMode = oldRecordMode;
 }
 
@@ -558,6 +598,10 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	// The control panel is not shown in benchmark mode
+	if (_benchmark) {
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -572,6 +616,9 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -674,6 +721,131 @@ void EventRecorder::deleteTemporarySave() {
 	_temporarySlot = -1;
 }
 
+/**
+ * Real time in microseconds, which is not affected by the playback.
+ * SDL 1.2 only has a millisecond timer, so the system clock is used where
+ * there is one.
+ */
+static uint64 getBenchmarkMicros() {
+#if defined(WIN32)
+	static LARGE_INTEGER frequency;
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	const uint64 ticks = counter.QuadPart;
+	const uint64 ticksPerSecond = frequency.QuadPart;
+	// Split the conversion, multiplying the counter right away would
+	// overflow after a few months of uptime
+	return ticks / ticksPerSecond * 1000000 + ticks % ticksPerSecond * 1000000 / ticksPerSecond;
+#elif defined(POSIX)
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+void EventRecorder::initBenchmark() {
+	_benchmark = true;
+	_benchmarkReported = false;
+	_fastPlayback = true;
+	_needRedraw = false;
+	_frameTimes.clear();
+	for (int i = 0; i < kBenchmarkSectionCount; i++) {
+		_frameSectionTime[i] = 0;
+		_totalSectionTime[i] = 0;
+	}
+
+	Common::String fileName = ConfMan.get("benchmark_file");
+	if (!fileName.empty()) {
+		if (_benchmarkFile.open(fileName)) {
+			_benchmarkFile.writeString("{\n\"frames\": [\n");
+		} else {
+			warning("Could not open benchmark file '%s'", fileName.c_str());
+		}
+	}
+
+	_benchmarkStartTime = _frameStartTime = getBenchmarkMicros();
+	debugC(1, kDebugLevelEventRec, "benchmark:action=start");
+}
+
+void EventRecorder::beginBenchmarkSection(BenchmarkSection section) {
+	if (_benchmark) {
+		_sectionStartTime[section] = getBenchmarkMicros();
+	}
+}
+
+void EventRecorder::endBenchmarkSection(BenchmarkSection section) {
+	if (_benchmark) {
+		_frameSectionTime[section] += getBenchmarkMicros() - _sectionStartTime[section];
+	}
+}
+
+void EventRecorder::finishBenchmarkFrame() {
+	if (!_benchmark || _benchmarkReported) {
+		return;
+	}
+
+	const uint64 now = getBenchmarkMicros();
+	const uint32 frameTime = now - _frameStartTime;
+	_frameStartTime = now;
+
+	Common::String line = Common::String::format("[%d, %u, %u, %u, %u]", _frameTimes.size(), frameTime,
+	                                             _frameSectionTime[kBenchmarkScript], _frameSectionTime[kBenchmarkRender],
+	                                             _frameSectionTime[kBenchmarkAudio]);
+	if (_benchmarkFile.isOpen()) {
+		_benchmarkFile.writeString(Common::String(_frameTimes.empty() ? "" : ",\n") + line);
+	}
+	debugC(2, kDebugLevelEventRec, "benchmark:frame=%d time=%u script=%u render=%u audio=%u", _frameTimes.size(), frameTime,
+	       _frameSectionTime[kBenchmarkScript], _frameSectionTime[kBenchmarkRender], _frameSectionTime[kBenchmarkAudio]);
+
+	_frameTimes.push_back(frameTime);
+	for (int i = 0; i < kBenchmarkSectionCount; i++) {
+		_totalSectionTime[i] += _frameSectionTime[i];
+		_frameSectionTime[i] = 0;
+	}
+}
+
+void EventRecorder::reportBenchmark() {
+	if (!_benchmark || _benchmarkReported) {
+		return;
+	}
+	_benchmarkReported = true;
+
+	const uint32 totalTime = (getBenchmarkMicros() - _benchmarkStartTime) / 1000;
+	const uint frames = _frameTimes.size();
+	Common::sort(_frameTimes.begin(), _frameTimes.end());
+
+	uint64 frameTimeSum = 0;
+	for (uint i = 0; i < frames; i++) {
+		frameTimeSum += _frameTimes[i];
+	}
+
+	// Frame times are in microseconds, totals in milliseconds
+	Common::String summary = Common::String::format(
+		"{\"target\": \"%s\", \"record\": \"%s\", \"frames\": %u, \"replayed_ms\": %u, \"total_ms\": %u, "
+		"\"frame_us\": {\"avg\": %u, \"min\": %u, \"median\": %u, \"p95\": %u, \"max\": %u}, "
+		"\"section_ms\": {\"script\": %u, \"render\": %u, \"audio\": %u}}",
+		ConfMan.getActiveDomainName().c_str(), _recordFileName.c_str(), frames, _fakeTimer, totalTime,
+		frames ? (uint32)(frameTimeSum / frames) : 0,
+		frames ? _frameTimes[0] : 0,
+		frames ? _frameTimes[frames / 2] : 0,
+		frames ? _frameTimes[frames * 95 / 100] : 0,
+		frames ? _frameTimes[frames - 1] : 0,
+		(uint32)(_totalSectionTime[kBenchmarkScript] / 1000), (uint32)(_totalSectionTime[kBenchmarkRender] / 1000),
+		(uint32)(_totalSectionTime[kBenchmarkAudio] / 1000));
+
+	if (_benchmarkFile.isOpen()) {
+		_benchmarkFile.writeString("\n],\n\"summary\": " + summary + "\n}\n");
+		_benchmarkFile.finalize();
+		_benchmarkFile.close();
+	}
+	debug("benchmark:summary=%s", summary.c_str());
+}
+
 } // End of namespace GUI
 
 #endif // ENABLE_EVENTRECORDER
@@ -46,6 +46,7 @@
 #include "backends/saves/recorder/recorder-saves.h"
 #include "backends/mixer/nullmixer/nullsdl-mixer.h"
 #include "backends/saves/default/default-saves.h"
+#include "common/file.h"
 
 
 #define g_eventRec (GUI::EventRecorder::instance())
@@ -78,6 +79,14 @@ public:
 		kRecorderPlaybackPause = 3	/**< kRecordetPlaybackPause, interal state when user pauses the playback */
 	};
 
+	/** Parts of a frame which are timed separately in benchmark mode */
+	enum BenchmarkSection {
+		kBenchmarkScript = 0,		/**< kBenchmarkScript, running the engine scripts */
+		kBenchmarkRender = 1,		/**< kBenchmarkRender, updating the screen */
+		kBenchmarkAudio = 2,		/**< kBenchmarkAudio, mixing audio */
+		kBenchmarkSectionCount = 3
+	};
+
 	void init(Common::String recordFileName, RecordMode mode);
 	void deinit();
 	bool processDelayMillis();
@@ -175,6 +184,20 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/** Whether a recording is played back in benchmark mode */
+	bool isBenchmark() const {
+		return _benchmark;
+	}
+
+	/** Start and stop timing a part of the current frame in benchmark mode.
+	 *  Sections must not be nested into themselves.
+	 */
+	void beginBenchmarkSection(BenchmarkSection section);
+	void endBenchmarkSection(BenchmarkSection section);
+
+	/** Called after each screen update, to account the frame in benchmark mode */
+	void finishBenchmarkFrame();
+
 private:
 	virtual Common::List<Common::Event> mapEvent(const Common::Event &ev, Common::EventSource *source);
 	bool notifyPoll();
@@ -229,6 +252,19 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	bool _benchmark;
+	bool _benchmarkReported;
+	Common::DumpFile _benchmarkFile;
+	uint64 _benchmarkStartTime;
+	uint64 _frameStartTime;
+	uint64 _sectionStartTime[kBenchmarkSectionCount];
+	uint32 _frameSectionTime[kBenchmarkSectionCount];
+	uint64 _totalSectionTime[kBenchmarkSectionCount];
+	Common::Array<uint32> _frameTimes;
+
+	void initBenchmark();
+	void reportBenchmark();
 };
 
 } // End of namespace GUI
@@ -67,6 +67,12 @@ public:
 	 */
 	bool isActive() const { return _isActive; }
 
+	/**
+	 * Return true if the debugger is attached, i.e. if it is going to
+	 * activate on one of the next onFrame() calls.
+	 */
+	bool isAttached() const { return _frameCountdown > 0; }
+
 protected:
 	typedef Common::Functor2<int, const char **, bool> Debuglet;
 
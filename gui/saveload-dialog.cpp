@@ -96,6 +96,21 @@ void SaveLoadChooserDialog::open() {
 	setResult(-1);
 }
 
+void SaveLoadChooserDialog::close() {
+	// The savefiles might change while the dialog is closed.
+	_metaInfoCache.clear();
+
+	Dialog::close();
+}
+
+const SaveStateDescriptor &SaveLoadChooserDialog::getSaveMetaInfos(int slot) {
+	MetaInfoCache::iterator i = _metaInfoCache.find(slot);
+	if (i != _metaInfoCache.end())
+		return i->_value;
+
+	return _metaInfoCache[slot] = _metaEngine->querySaveMetaInfos(_target.c_str(), slot);
+}
+
 int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *metaEngine) {
 	_metaEngine = metaEngine;
 	_target = target;
@@ -276,6 +291,7 @@ void SaveLoadChooserSimple::handleCommand(CommandSender *sender, uint32 cmd, uin
 								_("Delete"), _("Cancel"));
 			if (alert.runModal() == kMessageOK) {
 				_metaEngine->removeSaveState(_target.c_str(), _saveList[selItem].getSaveSlot());
+				invalidateSaveMetaInfos(_saveList[selItem].getSaveSlot());
 
 				setResult(-1);
 				_list->setSelected(-1);
@@ -362,7 +378,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		const SaveStateDescriptor &desc = getSaveMetaInfos(_saveList[selItem].getSaveSlot());
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -619,6 +635,24 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 	}
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	// Querying the meta information opens the savefile and decodes its
+	// thumbnail, which can take a while with lots of saves on slow storage.
+	// Thus we only load one slot per tickle and let the page fill in
+	// progressively instead of blocking the GUI.
+	if (!_pendingButtons.empty()) {
+		const uint curNum = _pendingButtons.front();
+		_pendingButtons.remove_at(0);
+
+		const int saveSlot = _saveList[_curPage * _entriesPerPage + curNum].getSaveSlot();
+		SlotButton &curButton = _buttons[curNum];
+		updateSlotButton(curButton, saveSlot, getSaveMetaInfos(saveSlot));
+		curButton.container->draw();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
@@ -787,6 +821,8 @@ void SaveLoadChooserGrid::close() {
 		ConfMan.setInt("gui_saveload_last_pos", !_saveList.empty() ? _saveList[_curPage * _entriesPerPage].getSaveSlot() : 0);
 	}
 
+	_pendingButtons.clear();
+
 	SaveLoadChooserDialog::close();
 	hideButtons();
 }
@@ -850,54 +886,26 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
+	_pendingButtons.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+		const int saveSlot = _saveList[i].getSaveSlot();
 
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
 
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
+		if (hasCachedSaveMetaInfos(saveSlot)) {
+			updateSlotButton(curButton, saveSlot, getSaveMetaInfos(saveSlot));
+		} else {
+			// Show what the save list knows about the slot for now, the
+			// thumbnail and the rest are filled in by handleTickle().
+			updateSlotButton(curButton, saveSlot, _saveList[i]);
 
-		curButton.button->setTooltip(tooltip);
+			// We do not know yet whether the slot is write protected.
+			if (_saveMode)
+				curButton.button->setEnabled(false);
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
+			_pendingButtons.push_back(curNum);
 		}
 	}
 
@@ -915,6 +923,51 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, int saveSlot, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(thumbnail);
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
@@ -28,6 +28,8 @@
 
 #include "engines/metaengine.h"
 
+#include "common/hashmap.h"
+
 namespace GUI {
 
 #define kSwitchSaveLoadDialog -2
@@ -55,6 +57,7 @@ public:
 	SaveLoadChooserDialog(int x, int y, int w, int h, const bool saveMode);
 
 	virtual void open();
+	virtual void close();
 
 	virtual void reflowLayout();
 
@@ -70,6 +73,15 @@ public:
 protected:
 	virtual int runIntern() = 0;
 
+	/**
+	 * Query the meta information of a save slot. The result is kept until
+	 * the dialog is closed, so that going back and forth between entries or
+	 * pages only opens each savefile once.
+	 */
+	const SaveStateDescriptor &getSaveMetaInfos(int slot);
+	bool hasCachedSaveMetaInfos(int slot) const { return _metaInfoCache.contains(slot); }
+	void invalidateSaveMetaInfos(int slot) { _metaInfoCache.erase(slot); }
+
 	const bool				_saveMode;
 	const MetaEngine		*_metaEngine;
 	bool					_delSupport;
@@ -86,6 +98,10 @@ protected:
 	void addChooserButtons();
 	ButtonWidget *createSwitchButton(const Common::String &name, const char *desc, const char *tooltip, const char *image, uint32 cmd = 0);
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
+
+private:
+	typedef Common::HashMap<int, SaveStateDescriptor> MetaInfoCache;
+	MetaInfoCache _metaInfoCache;
 };
 
 class SaveLoadChooserSimple : public SaveLoadChooserDialog {
@@ -164,6 +180,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 private:
 	virtual int runIntern();
 
@@ -201,6 +218,11 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, int saveSlot, const SaveStateDescriptor &desc);
+
+	// Buttons on the current page whose meta information is still to be
+	// loaded. One of them is filled in on every tickle.
+	Common::Array<uint> _pendingButtons;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
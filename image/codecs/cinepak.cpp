@@ -34,18 +34,31 @@
 
 namespace Image {
 
-#define PUT_PIXEL(offset, lum, u, v) \
-	if (_pixelFormat.bytesPerPixel != 1) { \
-		byte r = _clipTable[lum + (v << 1)]; \
-		byte g = _clipTable[lum - (u >> 1) - v]; \
-		byte b = _clipTable[lum + (u << 1)]; \
-		\
-		if (_pixelFormat.bytesPerPixel == 2) \
-			*((uint16 *)_curFrame.surface->getPixels() + offset) = _pixelFormat.RGBToColor(r, g, b); \
-		else \
-			*((uint32 *)_curFrame.surface->getPixels() + offset) = _pixelFormat.RGBToColor(r, g, b); \
-	} else \
-		*((byte *)_curFrame.surface->getPixels() + offset) = lum
+/**
+ * Fill a 4x4 block with a v1 codebook entry, where each pixel of the
+ * entry covers a 2x2 area.
+ */
+template<typename PixelInt>
+static inline void putV1Block(PixelInt *dst, uint pitch, const CinepakCodebook &codebook) {
+	const PixelInt p0 = codebook.pixels[0], p1 = codebook.pixels[1];
+	const PixelInt p2 = codebook.pixels[2], p3 = codebook.pixels[3];
+
+	dst[0] = dst[1] = p0; dst[2] = dst[3] = p1; dst += pitch;
+	dst[0] = dst[1] = p0; dst[2] = dst[3] = p1; dst += pitch;
+	dst[0] = dst[1] = p2; dst[2] = dst[3] = p3; dst += pitch;
+	dst[0] = dst[1] = p2; dst[2] = dst[3] = p3;
+}
+
+/**
+ * Fill a 2x2 block with a v4 codebook entry.
+ */
+template<typename PixelInt>
+static inline void putV4Block(PixelInt *dst, uint pitch, const CinepakCodebook &codebook) {
+	dst[0] = codebook.pixels[0];
+	dst[1] = codebook.pixels[1];
+	dst[pitch + 0] = codebook.pixels[2];
+	dst[pitch + 1] = codebook.pixels[3];
+}
 
 CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec() {
 	_curFrame.surface = NULL;
@@ -216,22 +229,53 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].u = 0;
 				codebook[i].v = 0;
 			}
+
+			convertCodebookEntry(codebook[i]);
 		}
 	}
 }
 
+void CinepakDecoder::convertCodebookEntry(CinepakCodebook &entry) const {
+	// Palettized video uses the luminance as the palette index
+	if (_pixelFormat.bytesPerPixel == 1) {
+		for (int i = 0; i < 4; i++)
+			entry.pixels[i] = entry.y[i];
+		return;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		byte r = _clipTable[entry.y[i] + (entry.v << 1)];
+		byte g = _clipTable[entry.y[i] - (entry.u >> 1) - entry.v];
+		byte b = _clipTable[entry.y[i] + (entry.u << 1)];
+		entry.pixels[i] = _pixelFormat.RGBToColor(r, g, b);
+	}
+}
+
 void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
+	switch (_pixelFormat.bytesPerPixel) {
+	case 1:
+		decodeVectorsTmpl<byte>(stream, strip, chunkID, chunkSize);
+		break;
+	case 2:
+		decodeVectorsTmpl<uint16>(stream, strip, chunkID, chunkSize);
+		break;
+	default:
+		decodeVectorsTmpl<uint32>(stream, strip, chunkID, chunkSize);
+		break;
+	}
+}
+
+template<typename PixelInt>
+void CinepakDecoder::decodeVectorsTmpl(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	uint32 flag = 0, mask = 0;
-	uint32 iy[4];
 	int32 startPos = stream.pos();
+	const CinepakStrip &curStrip = _curFrame.strips[strip];
+	const uint pitch = _curFrame.surface->pitch / sizeof(PixelInt);
 
-	for (uint16 y = _curFrame.strips[strip].rect.top; y < _curFrame.strips[strip].rect.bottom; y += 4) {
-		iy[0] = _curFrame.strips[strip].rect.left + y * _curFrame.width;
-		iy[1] = iy[0] + _curFrame.width;
-		iy[2] = iy[1] + _curFrame.width;
-		iy[3] = iy[2] + _curFrame.width;
+	for (uint16 y = curStrip.rect.top; y < curStrip.rect.bottom; y += 4) {
+		PixelInt *dst = (PixelInt *)_curFrame.surface->getBasePtr(curStrip.rect.left, y);
 
-		for (uint16 x = _curFrame.strips[strip].rect.left; x < _curFrame.strips[strip].rect.right; x += 4) {
+		for (uint16 x = curStrip.rect.left; x < curStrip.rect.right; x += 4, dst += 4) {
 			if ((chunkID & 0x01) && !(mask >>= 1)) {
 				if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 					return;
@@ -254,59 +298,19 @@ void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 st
 						return;
 
 					// Get the codebook
-					CinepakCodebook codebook = _curFrame.strips[strip].v1_codebook[stream.readByte()];
-
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[0], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[0] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[1], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[2], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					putV1Block(dst, pitch, curStrip.v1_codebook[stream.readByte()]);
 				} else if (flag & mask) {
 					if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
-					CinepakCodebook codebook = _curFrame.strips[strip].v4_codebook[stream.readByte()];
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream.readByte()];
-					PUT_PIXEL(iy[0] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream.readByte()];
-					PUT_PIXEL(iy[2] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream.readByte()];
-					PUT_PIXEL(iy[2] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					byte codebookIndex[4];
+					stream.read(codebookIndex, 4);
+					putV4Block(dst, pitch, curStrip.v4_codebook[codebookIndex[0]]);
+					putV4Block(dst + 2, pitch, curStrip.v4_codebook[codebookIndex[1]]);
+					putV4Block(dst + pitch * 2, pitch, curStrip.v4_codebook[codebookIndex[2]]);
+					putV4Block(dst + pitch * 2 + 2, pitch, curStrip.v4_codebook[codebookIndex[3]]);
 				}
 			}
-
-			for (byte i = 0; i < 4; i++)
-				iy[i] += 4;
 		}
 	}
 }
@@ -39,6 +39,10 @@ struct CinepakCodebook {
 	// These are not in the normal YUV colorspace, but in the Cinepak YUV colorspace instead.
 	byte y[4]; // [0, 255]
 	int8 u, v; // [-128, 127]
+
+	// The four pixels of the entry, converted to the output format when
+	// the codebook is loaded
+	uint32 pixels[4];
 };
 
 struct CinepakStrip {
@@ -79,7 +83,11 @@ private:
 	byte *_clipTable, *_clipTableBuf;
 
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
+	void convertCodebookEntry(CinepakCodebook &entry) const;
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
+
+	template<typename PixelInt>
+	void decodeVectorsTmpl(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 };
 
 } // End of namespace Image
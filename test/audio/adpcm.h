@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/adpcm.h"
+#include "audio/audiostream.h"
+
+#include "common/memstream.h"
+
+class ADPCMStreamTestSuite : public CxxTest::TestSuite
+{
+private:
+	/**
+	 * Create an ADPCM stream of the given type over pseudo-random data.
+	 */
+	Audio::RewindableAudioStream *createNoiseStream(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 size) {
+		byte *data = (byte *)malloc(size);
+		uint32 seed = 0x1234;
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (seed >> 16) & 0xFF;
+		}
+
+		// MS IMA block headers hold the step index, which has to be valid
+		if (type == Audio::kADPCMMSIma) {
+			for (uint32 block = 0; block < size; block += blockAlign) {
+				for (int i = 0; i < channels; i++) {
+					data[block + i * 4 + 2] %= 89;
+					data[block + i * 4 + 3] = 0;
+				}
+			}
+		}
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+		return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+	}
+
+	/**
+	 * Decode the whole stream, requesting chunkSize samples at a time.
+	 * @return	the number of samples decoded
+	 */
+	int decodeAll(Audio::AudioStream *s, int16 *buffer, int maxSamples, int chunkSize) {
+		int total = 0;
+		while (!s->endOfData() && total < maxSamples) {
+			int samples = s->readBuffer(buffer + total, MIN(chunkSize, maxSamples - total));
+			if (samples <= 0)
+				break;
+			total += samples;
+		}
+		return total;
+	}
+
+	/**
+	 * Check that the decoded output does not depend on how many samples
+	 * are requested per readBuffer call.
+	 */
+	void chunkSizeTestTemplate(Audio::ADPCMType type, int channels, uint32 blockAlign, int expectedSamples) {
+		const uint32 size = 8 * 1024;
+		const int chunkSizes[] = { 2, 6, 30, 1000, 65536 };
+
+		Audio::RewindableAudioStream *s = createNoiseStream(type, channels, blockAlign, size);
+		int16 *reference = new int16[expectedSamples + 16];
+		int16 *buffer = new int16[expectedSamples + 16];
+
+		TS_ASSERT_EQUALS(decodeAll(s, reference, expectedSamples + 16, 65536), expectedSamples);
+		TS_ASSERT(s->endOfData());
+
+		for (int i = 0; i < ARRAYSIZE(chunkSizes); i++) {
+			TS_ASSERT(s->rewind());
+			TS_ASSERT_EQUALS(decodeAll(s, buffer, expectedSamples + 16, chunkSizes[i]), expectedSamples);
+			TS_ASSERT_EQUALS(memcmp(reference, buffer, sizeof(int16) * expectedSamples), 0);
+			TS_ASSERT(s->endOfData());
+		}
+
+		delete[] buffer;
+		delete[] reference;
+		delete s;
+	}
+
+public:
+	void test_oki_chunk_sizes() {
+		chunkSizeTestTemplate(Audio::kADPCMOki, 1, 0, 16 * 1024);
+	}
+
+	void test_dvi_chunk_sizes() {
+		chunkSizeTestTemplate(Audio::kADPCMDVI, 1, 0, 16 * 1024);
+		chunkSizeTestTemplate(Audio::kADPCMDVI, 2, 0, 16 * 1024);
+	}
+
+	void test_ms_ima_chunk_sizes() {
+		// Each 512 byte block has a 4 byte header per channel
+		chunkSizeTestTemplate(Audio::kADPCMMSIma, 1, 512, 16 * (512 - 4) * 2);
+		chunkSizeTestTemplate(Audio::kADPCMMSIma, 2, 512, 16 * (512 - 8) * 2);
+	}
+
+	void test_ms_chunk_sizes() {
+		// Each 256 byte block has a 7 byte header per channel, which holds
+		// two samples of each channel
+		chunkSizeTestTemplate(Audio::kADPCMMS, 1, 256, 32 * ((256 - 7) * 2 + 2));
+		chunkSizeTestTemplate(Audio::kADPCMMS, 2, 256, 32 * ((256 - 14) * 2 + 4));
+	}
+
+	void test_oki_odd_reads() {
+		// Every byte holds two samples, make sure the second one is not lost
+		// when only one is requested
+		static const byte data[] = { 0x00, 0x00 };
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, sizeof(data));
+		Audio::AudioStream *s = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, sizeof(data), Audio::kADPCMOki, 22050, 1);
+
+		int16 buffer[4];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, 1), 1);
+		TS_ASSERT_EQUALS(s->endOfData(), false);
+		TS_ASSERT_EQUALS(s->readBuffer(buffer + 1, 3), 3);
+		TS_ASSERT_EQUALS(s->endOfData(), true);
+
+		TS_ASSERT_EQUALS(buffer[0], 32);
+		TS_ASSERT_EQUALS(buffer[1], 64);
+		TS_ASSERT_EQUALS(buffer[2], 96);
+		TS_ASSERT_EQUALS(buffer[3], 128);
+
+		delete s;
+	}
+
+	void test_ms_stereo_block_header() {
+		// The header holds sample2 and sample1 of each channel, which have to
+		// come out interleaved and in that order
+		static const byte data[] = {
+			0x00, 0x00,             // predictors
+			0x10, 0x00, 0x10, 0x00, // deltas
+			0x64, 0x00, 0xC8, 0x00, // sample1: 100, 200
+			0x0A, 0x00, 0x14, 0x00  // sample2: 10, 20
+		};
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, sizeof(data));
+		Audio::AudioStream *s = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, sizeof(data), Audio::kADPCMMS, 22050, 2, sizeof(data));
+
+		int16 buffer[4];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, 4), 4);
+		TS_ASSERT_EQUALS(s->endOfData(), true);
+
+		TS_ASSERT_EQUALS(buffer[0], 10);
+		TS_ASSERT_EQUALS(buffer[1], 20);
+		TS_ASSERT_EQUALS(buffer[2], 100);
+		TS_ASSERT_EQUALS(buffer[3], 200);
+
+		delete s;
+	}
+};
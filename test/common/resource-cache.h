@@ -0,0 +1,158 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/resource-cache.h"
+
+namespace {
+
+typedef Common::ResourceCache<int, int> IntCache;
+
+struct EvictLog {
+	int count;
+	int lastKey;
+	int lastValue;
+};
+
+void logEviction(const int &key, int &value, void *refCon) {
+	EvictLog *log = (EvictLog *)refCon;
+	log->count++;
+	log->lastKey = key;
+	log->lastValue = value;
+}
+
+} // End of anonymous namespace
+
+class ResourceCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_get_insert() {
+		IntCache cache(100);
+
+		TS_ASSERT(!cache.get(1));
+		cache.insert(1, 10, 40);
+		cache.insert(2, 20, 40);
+
+		TS_ASSERT(cache.contains(1));
+		TS_ASSERT_EQUALS(*cache.get(1), 10);
+		TS_ASSERT_EQUALS(*cache.get(2), 20);
+		TS_ASSERT_EQUALS(cache.getSize(), 80u);
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+		TS_ASSERT_EQUALS(cache.getHits(), 2u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		// Replacing an entry updates the size accounting
+		cache.insert(2, 21, 10);
+		TS_ASSERT_EQUALS(*cache.get(2), 21);
+		TS_ASSERT_EQUALS(cache.getSize(), 50u);
+	}
+
+	void test_lru_eviction() {
+		EvictLog log = { 0, 0, 0 };
+		IntCache cache(100, logEviction, &log);
+
+		cache.insert(1, 10, 40);
+		cache.insert(2, 20, 40);
+		cache.get(1);
+
+		// 2 is the least recently used entry now
+		cache.insert(3, 30, 40);
+		TS_ASSERT_EQUALS(log.count, 1);
+		TS_ASSERT_EQUALS(log.lastKey, 2);
+		TS_ASSERT_EQUALS(log.lastValue, 20);
+		TS_ASSERT(cache.contains(1));
+		TS_ASSERT(!cache.contains(2));
+		TS_ASSERT(cache.contains(3));
+		TS_ASSERT_EQUALS(cache.getEvictions(), 1u);
+
+		// An entry larger than the budget evicts everything else, but is kept
+		cache.insert(4, 40, 500);
+		TS_ASSERT_EQUALS(log.count, 3);
+		TS_ASSERT_EQUALS(cache.getCount(), 1u);
+		TS_ASSERT(cache.contains(4));
+
+		cache.setBudget(0);
+		TS_ASSERT_EQUALS(log.count, 4);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.evictOldest());
+	}
+
+	void test_evict_oldest() {
+		EvictLog log = { 0, 0, 0 };
+		IntCache cache(100, logEviction, &log);
+
+		cache.insert(1, 10, 10);
+		cache.insert(2, 20, 10);
+		cache.insert(3, 30, 10);
+		cache.pin(1);
+		cache.get(2);
+
+		TS_ASSERT(cache.evictOldest());
+		TS_ASSERT_EQUALS(log.lastKey, 3);
+		TS_ASSERT(cache.evictOldest());
+		TS_ASSERT_EQUALS(log.lastKey, 2);
+		TS_ASSERT(!cache.evictOldest());
+		TS_ASSERT(cache.contains(1));
+		TS_ASSERT_EQUALS(cache.getEvictions(), 2u);
+	}
+
+	void test_pin() {
+		EvictLog log = { 0, 0, 0 };
+		IntCache cache(100, logEviction, &log);
+
+		cache.insert(1, 10, 60);
+		cache.pin(1);
+		cache.pin(1);
+		TS_ASSERT(cache.isPinned(1));
+
+		// Pinned entries are not evicted, even if the budget is exceeded
+		cache.insert(2, 20, 60);
+		TS_ASSERT_EQUALS(log.count, 0);
+		TS_ASSERT_EQUALS(cache.getSize(), 120u);
+
+		cache.insert(3, 30, 60);
+		TS_ASSERT_EQUALS(log.count, 1);
+		TS_ASSERT_EQUALS(log.lastKey, 2);
+
+		cache.unpin(1);
+		TS_ASSERT(cache.isPinned(1));
+		TS_ASSERT_EQUALS(log.count, 1);
+
+		// Once unpinned, the entry becomes the most recently used one. The
+		// owner may still be using it, so nothing is evicted right away.
+		cache.unpin(1);
+		TS_ASSERT(!cache.isPinned(1));
+		TS_ASSERT_EQUALS(log.count, 1);
+		TS_ASSERT_EQUALS(cache.getSize(), 120u);
+
+		// The cache shrinks back to its budget on the next insertion
+		cache.insert(4, 40, 10);
+		TS_ASSERT_EQUALS(log.count, 2);
+		TS_ASSERT_EQUALS(log.lastKey, 3);
+		TS_ASSERT(cache.contains(1));
+		TS_ASSERT_EQUALS(cache.getSize(), 70u);
+	}
+
+	void test_remove_clear() {
+		EvictLog log = { 0, 0, 0 };
+		IntCache cache(100, logEviction, &log);
+
+		cache.insert(1, 10, 10);
+		cache.insert(2, 20, 10);
+		cache.insert(3, 30, 10);
+		cache.pin(3);
+
+		TS_ASSERT(cache.remove(2));
+		TS_ASSERT(!cache.remove(2));
+		TS_ASSERT_EQUALS(log.count, 1);
+		TS_ASSERT_EQUALS(log.lastValue, 20);
+
+		// Explicit removal is not counted as eviction
+		TS_ASSERT_EQUALS(cache.getEvictions(), 0u);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(log.count, 3);
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+
+		cache.insert(4, 40, 10);
+		TS_ASSERT_EQUALS(*cache.get(4), 40);
+	}
+};
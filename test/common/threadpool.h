@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+
+namespace {
+
+class SumTask : public Common::Task {
+public:
+	SumTask(int n) : _n(n), _result(0) {}
+
+	virtual void run() {
+		for (int i = 1; i <= _n; i++)
+			_result += i;
+	}
+
+	int _n;
+	int _result;
+};
+
+// Pretends to have workers, so that parallelFor splits the range
+class FakeWorkerThreadPool : public Common::ThreadPool {
+public:
+	FakeWorkerThreadPool(uint workers) : _workers(workers), _submitted(0) {}
+
+	virtual uint getWorkerCount() const { return _workers; }
+
+	virtual void submit(Common::Task *task) {
+		_submitted++;
+		ThreadPool::submit(task);
+	}
+
+	uint _workers;
+	int _submitted;
+};
+
+void markRange(int begin, int end, void *refCon) {
+	int *counts = (int *)refCon;
+	for (int i = begin; i < end; i++)
+		counts[i]++;
+}
+
+} // End of anonymous namespace
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void test_submit_wait() {
+		Common::ThreadPool pool;
+		SumTask task(100);
+
+		TS_ASSERT_EQUALS(task.getState(), Common::Task::kStateIdle);
+		pool.submit(&task);
+		TS_ASSERT(task.isFinished());
+		pool.wait(&task);
+		TS_ASSERT_EQUALS(task.getState(), Common::Task::kStateIdle);
+		TS_ASSERT_EQUALS(task._result, 5050);
+
+		// Tasks can be resubmitted once waited for
+		pool.submit(&task);
+		pool.wait(&task);
+		TS_ASSERT_EQUALS(task._result, 10100);
+	}
+
+	void test_parallel_for_serial() {
+		Common::ThreadPool pool;
+		int counts[37];
+		memset(counts, 0, sizeof(counts));
+
+		pool.parallelFor(0, 37, markRange, counts);
+		for (int i = 0; i < 37; i++)
+			TS_ASSERT_EQUALS(counts[i], 1);
+	}
+
+	void test_parallel_for_chunks() {
+		const int sizes[] = { 1, 2, 3, 5, 7, 16, 37 };
+
+		for (uint workers = 1; workers <= 5; workers++) {
+			for (int s = 0; s < ARRAYSIZE(sizes); s++) {
+				FakeWorkerThreadPool pool(workers);
+				int counts[40];
+				memset(counts, 0, sizeof(counts));
+
+				pool.parallelFor(3, 3 + sizes[s], markRange, counts);
+
+				// Every element is visited exactly once, nothing outside the range
+				for (int i = 0; i < 40; i++)
+					TS_ASSERT_EQUALS(counts[i], (i >= 3 && i < 3 + sizes[s]) ? 1 : 0);
+
+				// The calling thread takes one chunk itself
+				TS_ASSERT(pool._submitted <= (int)workers);
+				TS_ASSERT(pool._submitted < sizes[s]);
+			}
+		}
+	}
+
+	void test_parallel_for_min_chunk_size() {
+		FakeWorkerThreadPool pool(3);
+		int counts[10];
+		memset(counts, 0, sizeof(counts));
+
+		pool.parallelFor(0, 10, markRange, counts, 8);
+		TS_ASSERT_EQUALS(pool._submitted, 1);
+
+		pool.parallelFor(0, 10, markRange, counts, 16);
+		TS_ASSERT_EQUALS(pool._submitted, 1);
+
+		pool.parallelFor(5, 5, markRange, counts);
+		for (int i = 0; i < 10; i++)
+			TS_ASSERT_EQUALS(counts[i], 2);
+	}
+};
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/scumm/gfx_compose.h"
+
+class ScummGfxComposeTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kMaxWidth = 320,
+		kGuard = 16
+	};
+
+	uint32 _seed;
+
+	byte nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) & 0xFF;
+	}
+
+	/**
+	 * Fill the given buffers with random pixels. About half of the text
+	 * pixels are transparent, and some of the others only differ from
+	 * CHARSET_MASK_TRANSPARENCY in a single bit.
+	 */
+	void fillRandom(byte *src, byte *text, int size) {
+		for (int i = 0; i < size; i++) {
+			src[i] = nextRandom();
+
+			const byte r = nextRandom();
+			if (r < 128)
+				text[i] = CHARSET_MASK_TRANSPARENCY;
+			else if (r < 160)
+				text[i] = CHARSET_MASK_TRANSPARENCY ^ (1 << (r & 7));
+			else
+				text[i] = nextRandom();
+		}
+	}
+
+public:
+	void test_compose_text_row() {
+		// uint32 buffers keep the rows 4 byte aligned
+		uint32 src32[kMaxWidth / 4], text32[kMaxWidth / 4];
+		uint32 dst32[(kMaxWidth + kGuard) / 4], ref32[(kMaxWidth + kGuard) / 4];
+		byte *src = (byte *)src32;
+		byte *text = (byte *)text32;
+		byte *dst = (byte *)dst32;
+		byte *ref = (byte *)ref32;
+
+		_seed = 0x1234;
+		for (int width = 4; width <= kMaxWidth; width += 4) {
+			fillRandom(src, text, width);
+			memset(dst, 0xAA, width + kGuard);
+			memset(ref, 0xAA, width + kGuard);
+
+			for (int i = 0; i < width; i++)
+				ref[i] = (text[i] == CHARSET_MASK_TRANSPARENCY) ? src[i] : text[i];
+
+			Scumm::composeTextRow(dst, src, text, width);
+			TS_ASSERT_SAME_DATA(dst, ref, width + kGuard);
+
+			memset(dst, 0xAA, width + kGuard);
+			Scumm::composeTextRow4(dst, src, text, width);
+			TS_ASSERT_SAME_DATA(dst, ref, width + kGuard);
+		}
+	}
+
+	void test_compose_text_row_all_values() {
+		// Every pixel value, both as text and as game graphics
+		uint32 src32[64], text32[64], dst32[64], ref32[64];
+		byte *src = (byte *)src32;
+		byte *text = (byte *)text32;
+		byte *dst = (byte *)dst32;
+		byte *ref = (byte *)ref32;
+
+		for (int i = 0; i < 256; i++) {
+			text[i] = i;
+			src[i] = 255 - i;
+			ref[i] = (i == CHARSET_MASK_TRANSPARENCY) ? src[i] : text[i];
+		}
+
+		Scumm::composeTextRow(dst, src, text, 256);
+		TS_ASSERT_SAME_DATA(dst, ref, 256);
+
+		Scumm::composeTextRow4(dst, src, text, 256);
+		TS_ASSERT_SAME_DATA(dst, ref, 256);
+	}
+
+	void test_cga_dither_pairs() {
+		byte pairs[2][256][2];
+		Scumm::buildCGADitherPairs(pairs);
+
+		for (int row = 0; row < 2; row++) {
+			for (int left = 0; left < 256; left++) {
+				for (int right = 0; right < 256; right++) {
+					const byte *pair = pairs[row][(left & 0xF) | ((right & 0xF) << 4)];
+					TS_ASSERT_EQUALS(pair[0], Scumm::cgaDither[row][0][left & 0xF]);
+					TS_ASSERT_EQUALS(pair[1], Scumm::cgaDither[row][1][right & 0xF]);
+				}
+			}
+		}
+	}
+};
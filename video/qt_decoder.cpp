@@ -539,71 +539,47 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
-
-	if (actualChunk < 0) {
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->sampleTable.size() || _parent->sampleTable[_curFrame].descId == 0) {
 		warning("Could not find data for frame %d", _curFrame);
 		return 0;
 	}
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+	const Common::QuickTimeParser::SampleEntry &sample = _parent->sampleTable[_curFrame];
+	descId = sample.descId;
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
+	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, sample.offset, sample.size);
 
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
-
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
-
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(sample.offset);
+	return stream->readStream(sample.size);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
-	uint32 curFrameIndex = 0;
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		curFrameIndex += _parent->timeToSample[i].count;
-		if ((uint32)_curFrame < curFrameIndex) {
-			// Ok, now we have what duration this frame has.
-			return _parent->timeToSample[i].duration;
-		}
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->sampleTable.size()) {
+		// This should never occur
+		error("Cannot find duration for frame %d", _curFrame);
+		return 0;
 	}
 
-	// This should never occur
-	error("Cannot find duration for frame %d", _curFrame);
-	return 0;
+	return _parent->sampleTable[_curFrame].duration;
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+	// The sync sample table is sorted, so look for the last key frame at or
+	// before the requested frame with a binary search
+	uint32 low = 0;
+	uint32 high = _parent->keyframeCount;
+
+	while (low < high) {
+		uint32 mid = (low + high) / 2;
+		if (_parent->keyframes[mid] <= frame)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if (low > 0)
+		return _parent->keyframes[low - 1];
 
 	// If none found, we'll assume the requested frame is a key frame
 	return frame;
@@ -617,30 +593,40 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
 	if (atLastEdit())
 		return;
 
-	uint32 frameNum = 0;
-	bool done = false;
-	uint32 totalDuration = 0;
-	uint32 prevDuration = 0;
-
 	// Track down where the mediaTime is in the media
 	// This is basically time -> frame mapping
 	// Note that this code uses first frame = 0
-	for (int32 i = 0; i < _parent->timeToSampleCount && !done; i++) {
-		for (int32 j = 0; j < _parent->timeToSample[i].count; j++) {
-			if (totalDuration == (uint32)_parent->editList[_curEdit].mediaTime) {
-				done = true;
-				prevDuration = totalDuration;
-				break;
-			} else if (totalDuration > (uint32)_parent->editList[_curEdit].mediaTime) {
-				done = true;
-				frameNum--;
-				break;
-			}
+	const Common::Array<Common::QuickTimeParser::SampleEntry> &samples = _parent->sampleTable;
+	const uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
+
+	// Find the first frame starting at or after mediaTime
+	uint32 low = 0;
+	uint32 high = samples.size();
+	while (low < high) {
+		uint32 mid = (low + high) / 2;
+		if (samples[mid].startTime < mediaTime)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	uint32 frameNum = low;
+	uint32 totalDuration = 0;
+	uint32 prevDuration = 0;
 
-			prevDuration = totalDuration;
-			totalDuration += _parent->timeToSample[i].duration;
-			frameNum++;
+	if (frameNum == samples.size()) {
+		// mediaTime is past the start of the last frame
+		if (frameNum > 0) {
+			prevDuration = samples[frameNum - 1].startTime;
+			totalDuration = prevDuration + samples[frameNum - 1].duration;
 		}
+	} else if (samples[frameNum].startTime == mediaTime) {
+		prevDuration = totalDuration = mediaTime;
+	} else {
+		// We came up in-between two frames
+		totalDuration = samples[frameNum].startTime;
+		frameNum--;
+		prevDuration = samples[frameNum].startTime;
 	}
 
 	if (bufferFrames) {
@@ -669,7 +655,9 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 
 	// Get the next packet
 	uint32 descId;
+	uint32 startTime = g_system->getMillis();
 	Common::SeekableReadStream *frameData = getNextFramePacket(descId);
+	uint32 readTime = g_system->getMillis() - startTime;
 
 	if (!frameData || !descId || descId > _parent->sampleDescs.size()) {
 		delete frameData;
@@ -684,9 +672,12 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 		return 0;
 	}
 
+	startTime = g_system->getMillis();
 	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
 	delete frameData;
 
+	debug(8, "QuickTime frame %d: read %d ms, decode %d ms", _curFrame, readTime, g_system->getMillis() - startTime);
+
 	// Update the palette
 	if (entry->_videoCodec->containsPalette()) {
 		// The codec itself contains a palette